@@ -0,0 +1,61 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Main.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include <Skyborn/Debug/Logger.h>
+
+#include <cstdio>
+
+using namespace sky;
+
+namespace
+{
+void print_line(logger::log_level::level, const char* line, void* out)
+{
+    fputs(line, (FILE*) out);
+}
+} // anonymous namespace
+
+// Turns binary logs written with logger::async_desc::binary_path back into text
+// Usage: logdecoder <binary log> [text output]
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fputs("Usage: logdecoder <binary log> [text output]\n", stderr);
+        return 1;
+    }
+
+    FILE* out{ argc > 2 ? fopen(argv[2], "w") : stdout };
+    if (!out)
+    {
+        fprintf(stderr, "Failed to open %s for writing\n", argv[2]);
+        return 1;
+    }
+
+    const bool ok{ logger::decode_binary_log(argv[1], print_line, out) };
+    if (out != stdout)
+        fclose(out);
+
+    return ok ? 0 : 1;
+}
\ No newline at end of file
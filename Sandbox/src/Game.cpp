@@ -24,6 +24,7 @@
 #include "Game.h"
 
 #include <Skyborn/Debug/Logger.h>
+#include <Skyborn/Core/Snapshot.h>
 
 using namespace sky::app;
 
@@ -31,6 +32,9 @@ namespace sandbox
 {
 bool init(game* game_inst)
 {
+    // Lets the engine save and roll back the game's state
+    sky::snapshot::register_state("sandbox", game_inst->state, sizeof(game_state));
+
     LOG_WARN("Sandbox game initialized");
     return true;
 }
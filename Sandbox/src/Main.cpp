@@ -62,7 +62,7 @@ bool create_game(app::game* game_inst)
     game_inst->render     = sandbox::render;
     game_inst->on_resize  = sandbox::on_resize;
 
-    game_inst->state = nullptr;
+    game_inst->state = new sandbox::game_state{};
 
     game_inst->app_state = nullptr;
 
@@ -71,5 +71,6 @@ bool create_game(app::game* game_inst)
 
 void shutdown_game(app::game* game_inst)
 {
+    delete (sandbox::game_state*) game_inst->state;
     game_inst->state = nullptr;
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Actions.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Input.h"
+#include "Skyborn/Debug/Asserts.h"
+
+#include <cstring>
+
+namespace sky::input
+{
+constexpr u32 max_actions = 64;
+
+using action_id = u32;
+
+/**
+ * Maps named gameplay actions ("jump", "fire") to any number of keys and mouse buttons. Call update once per frame
+ * with input::state(), then every query is a single bit test. Header only, so nothing crosses the DLL boundary
+ * Usage:
+ * input::action_map actions{};
+ * const input::action_id jump{ actions.add("jump") };
+ * actions.bind(jump, input::key::space);
+ * actions.update(input::state());
+ * if (actions.pressed(jump)) ...
+ */
+class action_map
+{
+public:
+    // Returns the action's id, the existing one if the name is already taken, or u32_invalid when full. The name
+    // isn't copied, so it must outlive the map
+    action_id add(const char* name)
+    {
+        const action_id existing{ find(name) };
+        if (existing != u32_invalid || m_count == max_actions)
+            return existing;
+
+        m_names[m_count] = name;
+        return m_count++;
+    }
+
+    // Meant for setup. Keep the id rather than looking it up every frame
+    [[nodiscard]] action_id find(const char* name) const
+    {
+        for (action_id i = 0; i < m_count; ++i)
+        {
+            if (!strcmp(m_names[i], name))
+                return i;
+        }
+        return u32_invalid;
+    }
+
+    void bind(action_id action, key::code k)
+    {
+        sky_assert(action < m_count);
+        m_keys[action].set(k, true);
+    }
+
+    void bind(action_id action, button::code b)
+    {
+        sky_assert(action < m_count);
+        m_buttons[action] |= 1u << b;
+    }
+
+    void unbind(action_id action, key::code k)
+    {
+        sky_assert(action < m_count);
+        m_keys[action].set(k, false);
+    }
+
+    void unbind(action_id action, button::code b)
+    {
+        sky_assert(action < m_count);
+        m_buttons[action] &= ~(1u << b);
+    }
+
+    // An action is down while any of its bindings is, so holding two of them doesn't press it twice. Presses and
+    // releases also come from the bindings' edges, so a binding tapped within one frame still counts
+    void update(const input_state& s)
+    {
+        u64 down      = 0;
+        u64 went_down = 0;
+        u64 went_up   = 0;
+        for (action_id i = 0; i < m_count; ++i)
+        {
+            const key_bits& keys{ m_keys[i] };
+            const u32       buttons{ m_buttons[i] };
+            down |= (u64) (keys.intersects(s.keys) || (buttons & s.buttons) != 0) << i;
+            went_down |= (u64) (keys.intersects(s.pressed_keys) || (buttons & s.pressed_buttons) != 0) << i;
+            went_up |= (u64) (keys.intersects(s.released_keys) || (buttons & s.released_buttons) != 0) << i;
+        }
+
+        m_pressed  = (down | went_down) & ~m_down;
+        m_released = (m_down | went_up) & ~down;
+        m_down     = down;
+    }
+
+    [[nodiscard]] constexpr bool down(action_id action) const { return (m_down >> action) & 1; }
+    [[nodiscard]] constexpr bool pressed(action_id action) const { return (m_pressed >> action) & 1; }
+    [[nodiscard]] constexpr bool released(action_id action) const { return (m_released >> action) & 1; }
+
+    [[nodiscard]] constexpr u32         count() const { return m_count; }
+    [[nodiscard]] constexpr const char* name(action_id action) const { return m_names[action]; }
+
+private:
+    key_bits    m_keys[max_actions]{};
+    u32         m_buttons[max_actions]{};
+    const char* m_names[max_actions]{};
+    u32         m_count{};
+    u64         m_down{};
+    u64         m_pressed{};
+    u64         m_released{};
+};
+} // namespace sky::input
\ No newline at end of file
@@ -28,9 +28,15 @@
 #include "Event.h"
 #include "Input.h"
 #include "Clock.h"
+#include "Thread.h"
+#include "Snapshot.h"
+#include "Recorder.h"
+#include "Timer.h"
 #include "Skyborn/Util/Util.h"
+#include "Skyborn/Util/AsyncIO.h"
 #include "Skyborn/Graphics/Renderer.h"
 
+#include <cstdlib>
 #include <filesystem>
 
 // TODO: Move
@@ -125,10 +131,32 @@ bool create(game* game_inst)
         return false;
     }
 
+    // SKY_LOG=<spec> sets log levels per category, see logger::configure
+    if (const char* log_spec{ std::getenv("SKY_LOG") })
+    {
+        logger::configure(log_spec);
+    }
+
+    // SKY_LOG_FILE=<path> also writes the log to rotating memory-mapped files
+    if (const char* log_path{ std::getenv("SKY_LOG_FILE") })
+    {
+        logger::file_sink_desc desc{};
+        desc.path = log_path;
+        logger::start_file_sink(desc);
+    }
+
+    if (game_inst->app_desc.async_logging)
+    {
+        logger::start_async();
+    }
+
     std::filesystem::path cwd = std::filesystem::current_path();
     LOG_DEBUG("Current working directory is set to: {}", cwd.string());
 
     LOG_INFO("Starting up application");
+    threading::set_thread_name("Main");
+    threading::get_cpu_topology(); // detect up front so worker placement doesn't pay for it later
+
     game_inst->app_state = create_ref<application_state>();
     // app_state            = ref<application_state>(game_inst->app_state.get());
     // app_state            = create_ref<application_state>();
@@ -149,12 +177,39 @@ bool create(game* game_inst)
         return false;
     }
 
+    if (!snapshot::initialize())
+    {
+        LOG_FATAL("Snapshot system failed to initialize");
+        return false;
+    }
+
+    if (!timers::initialize())
+    {
+        LOG_FATAL("Timer system failed to initialize");
+        return false;
+    }
+
+    if (!utl::aio::initialize())
+    {
+        LOG_FATAL("Async IO system failed to initialize");
+        return false;
+    }
+
+    // SKY_RECORD=<file> records the session's events and input, SKY_REPLAY=<file> plays a recording back
+    if (const char* replay_path{ std::getenv("SKY_REPLAY") })
+    {
+        recorder::start_replay(replay_path);
+    } else if (const char* record_path{ std::getenv("SKY_RECORD") })
+    {
+        recorder::start_recording(record_path);
+    }
+
     events::register_event(events::system_event::application_quit, nullptr, on_event);
     events::register_event(events::system_event::key_pressed, nullptr, on_key);
     events::register_event(events::system_event::key_released, nullptr, on_key);
     events::register_event(events::system_event::resized, nullptr, on_resized);
 
-    auto& [pos_x, pos_y, width, height, name] = game_inst->app_desc;
+    auto& [pos_x, pos_y, width, height, name, async_logging] = game_inst->app_desc;
 
     if (!platform::initialize(name, pos_x, pos_y, width, height))
     {
@@ -162,7 +217,7 @@ bool create(game* game_inst)
         return false;
     }
 
-    if (!graphics::initialize(graphics::backend_api::vulkan, game_inst->app_desc.name))
+    if (!graphics::initialize(graphics::default_backend, game_inst->app_desc.name))
     {
         LOG_FATAL("Failed to initialize renderer. Aborting...");
         return false;
@@ -190,38 +245,55 @@ bool run()
 
     constexpr f64 target_frame_time = 1.0 / 60.0;
 
+    u64 frame{};
+
     while (app_state->running)
     {
+        recorder::begin_frame(frame++);
+
         if (!platform::pump_messages())
         {
             app_state->running = false;
         }
+
+        // Everything the platform queued while pumping goes out in one batch
+        events::dispatch_queued();
+        input::latch();
         if (!app_state->suspended)
         {
             clock.update();
             const f64 current_time     = clock.elapsed();
             const f64 delta            = current_time - last_time;
             const f64 frame_start_time = platform::get_time();
-            if (!app_state->game_inst->update(app_state->game_inst, (f32) delta))
+
+            // A replay steps the game at a fixed rate, so runs can be compared frame by frame
+            f32 frame_delta{ (f32) delta };
+            recorder::fixed_delta(frame_delta);
+
+            timers::advance(frame_delta);
+            utl::aio::poll();
+
+            if (!app_state->game_inst->update(app_state->game_inst, frame_delta))
             {
                 LOG_FATAL("Game tick failed. Aborting...");
                 app_state->running = false;
                 break;
             }
 
-            if (!app_state->game_inst->render(app_state->game_inst, (f32) delta))
+            if (!app_state->game_inst->render(app_state->game_inst, frame_delta))
             {
                 LOG_FATAL("Game render failed. Aborting...");
                 app_state->running = false;
                 break;
             }
 
-            graphics::render_packet packet{ (f32) delta };
+            graphics::render_packet packet{ frame_delta };
             graphics::draw_frame(packet);
             ++fps;
 
             const f64 frame_end_time     = platform::get_time();
             const f64 frame_elapsed_time = frame_end_time - frame_start_time;
+            input::presented(frame_end_time);
 
             if (const f64 remaining_seconds = target_frame_time - frame_elapsed_time; remaining_seconds > 0.0)
             {
@@ -238,7 +310,7 @@ bool run()
             fps_clock.update();
             if (fps_clock.elapsed() >= 1.0)
             {
-                LOG_DEBUG("FPS: {}", fps);
+                LOG_CAT(frame, debug, "FPS: {}", fps);
                 fps = 0;
                 fps_clock.start();
             }
@@ -249,15 +321,25 @@ bool run()
 
     LOG_INFO("Shutting down...");
 
+    if (recorder::is_recording())
+    {
+        recorder::stop_recording();
+    }
+
     events::unregister_event(events::system_event::application_quit, nullptr, on_event);
     events::unregister_event(events::system_event::key_pressed, nullptr, on_key);
     events::unregister_event(events::system_event::key_released, nullptr, on_key);
     events::unregister_event(events::system_event::resized, nullptr, on_resized);
 
+    utl::aio::shutdown();
+    timers::shutdown();
+    snapshot::shutdown();
     events::shutdown();
     input::shutdown();
     graphics::shutdown();
     platform::shutdown();
+    logger::stop_async();
+    logger::stop_file_sink();
     return true;
 }
 
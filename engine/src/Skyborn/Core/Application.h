@@ -47,6 +47,8 @@ struct application_desc
     u16 height{};
 
     const char* name{};
+
+    bool async_logging{ true }; // Log from a background thread instead of writing on the caller's
 };
 
 struct game
@@ -22,9 +22,16 @@
 //
 // ------------------------------------------------------------------------------
 #include "Event.h"
+#include "Recorder.h"
 #include "Skyborn/Util/Vector.h"
 #include "Skyborn/Debug/Logger.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
 namespace sky::events
 {
 namespace
@@ -35,24 +42,184 @@ constexpr const char* event_names[] = {
     "button_released",  "mouse_moved", "mouse_wheel",  "resized",
 };
 
-static_assert(_countof(event_names) == system_event::count - 1);
+static_assert(std::size(event_names) == system_event::count - 1);
 
-constexpr u32 max_message_codes = 2 << 13; // random magic number stuffs
+const char* event_name(u16 code)
+{
+    return code && code < system_event::count ? event_names[code - 1] : "user";
+}
 
 bool is_initialized = false;
+bool stats_enabled  = true;
+
+f64 now()
+{
+    using namespace std::chrono;
+    return duration<f64>(steady_clock::now().time_since_epoch()).count();
+}
 
 struct registered_event
 {
     void*         listener;
     func_on_event callback;
+    i32           priority;
+    u64           invocations;
+    f64           time;
 };
 
+// Listeners of one code, stored contiguously
 struct event_code_entry
 {
-    utl::vector<registered_event> events{};
+    utl::vector<registered_event> events{}; // Sorted by descending priority
+    event_stats                   stats{};
+    u16                           code{};
+};
+
+// System codes index straight into a small table. User codes are rare and spread out, so they get an entry only once
+// registered, found through an open addressing hash of code -> entry index
+constexpr u32 system_code_count = system_event::max_code + 1;
+
+struct user_code_slot
+{
+    u16 code; // 0 marks an empty slot, since 0 is never a user code
+    u16 entry;
 };
 
-event_code_entry registered[max_message_codes];
+event_code_entry               system_codes[system_code_count]{};
+utl::vector<event_code_entry*> user_codes{}; // Stable, since the listener vectors can't be moved with memcpy
+utl::vector<user_code_slot>    user_slots{}; // Power of two sized
+
+u32 slot_of(u16 code, u32 mask)
+{
+    return ((u32) code * 0x9e37u) & mask;
+}
+
+void grow_user_slots()
+{
+    const u32 capacity{ user_slots.empty() ? 16u : (u32) user_slots.size() * 2 };
+    user_slots.clear();
+    user_slots.resize(capacity);
+
+    for (u32 i = 0; i < user_codes.size(); ++i)
+    {
+        u32 slot{ slot_of(user_codes[i]->code, capacity - 1) };
+        while (user_slots[slot].code)
+            slot = (slot + 1) & (capacity - 1);
+        user_slots[slot] = { user_codes[i]->code, (u16) i };
+    }
+}
+
+// Returns nullptr if nothing was ever registered for a user code and create is false
+event_code_entry* find_entry(u16 code, bool create)
+{
+    if (code < system_code_count)
+        return &system_codes[code];
+
+    if (!user_slots.empty())
+    {
+        const u32 mask{ (u32) user_slots.size() - 1 };
+        for (u32 slot{ slot_of(code, mask) }; user_slots[slot].code; slot = (slot + 1) & mask)
+        {
+            if (user_slots[slot].code == code)
+                return user_codes[user_slots[slot].entry];
+        }
+    }
+
+    if (!create)
+        return nullptr;
+
+    // Keep the load factor under 3/4 so probes stay short
+    if ((user_codes.size() + 1) * 4 > user_slots.size() * 3)
+        grow_user_slots();
+
+    const u32 mask{ (u32) user_slots.size() - 1 };
+    u32       slot{ slot_of(code, mask) };
+    while (user_slots[slot].code)
+        slot = (slot + 1) & mask;
+
+    user_slots[slot] = { code, (u16) user_codes.size() };
+    auto* entry = new event_code_entry{};
+    entry->code = code;
+    user_codes.push_back(entry);
+    return entry;
+}
+
+struct typed_event_entry
+{
+    utl::type_key                       key;
+    utl::vector<detail::typed_listener> listeners;
+    u32                                 emitting; // Nesting depth of emits in progress
+    bool                                has_dead; // Listeners unsubscribed mid-emit, removed once it's over
+};
+
+utl::vector<typed_event_entry*> typed_events{};
+u32                             next_listener_id{};
+
+// Payloads are stored inline so queued events never point back at the poster's stack
+struct queued_event
+{
+    void* sender;
+    u16   code;
+    u16   size;
+    alignas(8) u8 payload[max_payload_size];
+};
+
+// Posting goes to one queue while the other is being dispatched
+utl::vector<queued_event> queues[2]{};
+u32                       posting_queue{};
+utl::vector<u16>          dispatch_order{};
+
+// Bounded multi-producer, single-consumer ring for posts from other threads. Each cell's sequence says whose turn it
+// is: pos when free for the producer claiming pos, pos + 1 once written and ready for the consumer
+constexpr u32 thread_ring_size = 1024; // Power of two
+
+struct ring_cell
+{
+    std::atomic<u64> sequence;
+    queued_event     evt;
+};
+
+std::atomic<ring_cell*>        thread_ring{};
+std::atomic<u32>               ring_users{}; // Producers between loading thread_ring and finishing with it
+alignas(64) std::atomic<u64> ring_head{}; // Next position producers claim
+alignas(64) u64              ring_tail{}; // Next position the main thread reads
+
+// Held while using the ring, so shutdown can wait for everyone using it before freeing it. Both sides use
+// sequentially consistent operations: either the producer sees the ring gone, or shutdown sees the producer
+struct ring_user
+{
+    ring_user() { ring_users.fetch_add(1); }
+    ~ring_user() { ring_users.fetch_sub(1); }
+
+    [[nodiscard]] ring_cell* ring() const { return thread_ring.load(); }
+};
+
+struct coalesce_rule
+{
+    u16             code;
+    coalesce::mode  mode;
+    func_accumulate accumulate;
+    u32             pending; // Index of the code's event in the posting queue, or u32_invalid
+};
+
+// Only a handful of codes coalesce, so a short list beats a table indexed by code
+utl::vector<coalesce_rule> coalesce_rules{};
+
+void sum_wheel_deltas(void* into, const void* from)
+{
+    const i32 sum{ *(i8*) into + *(const i8*) from };
+    *(i8*) into = (i8) (sum < -128 ? -128 : sum > 127 ? 127 : sum);
+}
+
+coalesce_rule* find_rule(u16 code)
+{
+    for (auto& rule : coalesce_rules)
+    {
+        if (rule.code == code)
+            return &rule;
+    }
+    return nullptr;
+}
 
 } // anonymous namespace
 
@@ -61,41 +228,88 @@ bool initialize()
     if (is_initialized)
         return false;
 
+    ring_cell* ring{ new ring_cell[thread_ring_size]{} };
+    for (u32 i = 0; i < thread_ring_size; ++i)
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    ring_head.store(0, std::memory_order_relaxed);
+    ring_tail = 0;
+    thread_ring.store(ring);
+
     is_initialized = true;
+
+    set_coalescing(system_event::mouse_moved, coalesce::last_value);
+    set_coalescing(system_event::resized, coalesce::last_value);
+    set_coalescing(system_event::mouse_wheel, coalesce::accumulate, sum_wheel_deltas);
+
     LOG_INFO("Events submodule initialized");
     return true;
 }
 
 void shutdown()
 {
-    for (u16 i = 0; i < max_message_codes; ++i)
+    for (auto& entry : system_codes)
     {
-        if (!registered[i].events.empty())
+        if (!entry.events.empty())
         {
-            registered[i].events.clear();
+            entry.events.clear();
         }
+        entry.stats = {};
+    }
+
+    // Type ids are cached by event_type_id, so the types stay registered and only lose their listeners
+    for (typed_event_entry* entry : typed_events)
+    {
+        entry->listeners.clear();
+    }
+
+    for (event_code_entry* entry : user_codes)
+    {
+        SKY_DELETE(entry);
     }
+    user_codes.clear();
+    user_slots.clear();
+
+    queues[0].clear();
+    queues[1].clear();
+    coalesce_rules.clear();
+
+    // Whoever is still posting finishes first, later posts see no ring and fail
+    ring_cell* ring{ thread_ring.exchange(nullptr) };
+    while (ring_users.load())
+        std::this_thread::yield();
+    delete[] ring;
+
+    is_initialized = false;
     LOG_INFO("Events submodule shutdown");
 }
 
-bool register_event(u16 code, void* listener, func_on_event on_event)
+bool register_event(u16 code, void* listener, func_on_event on_event, i32 priority)
 {
     if (!is_initialized)
         return false;
 
-    const u64 register_count = registered[code].events.size();
+    utl::vector<registered_event>& events = find_entry(code, true)->events;
+    const u64                      register_count = events.size();
     for (u64 i = 0; i < register_count; ++i)
     {
-        if (registered[code].events[i].listener == listener)
+        if (events[i].listener == listener)
         {
-            LOG_WARN("Attempted to register a duplicate {} event", event_names[code - 1]);
+            LOG_WARN("Attempted to register a duplicate {} event", event_name(code));
             return false;
         }
     }
 
-    const registered_event evt{ listener, on_event };
-    registered[code].events.push_back(evt);
-    LOG_TRACE("Registered event {}", event_names[code - 1]);
+    // Insert after every listener of the same or higher priority, so equal priorities keep registration order
+    u64 index = register_count;
+    while (index > 0 && events[index - 1].priority < priority)
+        --index;
+
+    events.push_back({});
+    for (u64 i = register_count; i > index; --i)
+        events[i] = events[i - 1];
+    events[index] = { listener, on_event, priority, 0, 0.0 };
+
+    LOG_TRACE("Registered event {}", event_name(code));
     return true;
 }
 
@@ -104,13 +318,17 @@ bool unregister_event(u16 code, void* listener, func_on_event on_event)
     if (!is_initialized)
         return false;
 
-    utl::vector<registered_event>& events = registered[code].events;
+    event_code_entry* entry{ find_entry(code, false) };
+    if (!entry)
+        return false;
+
+    utl::vector<registered_event>& events = entry->events;
     for (u64 i = 0; i < events.size(); ++i)
     {
-        if (auto [lsn, callback]{ events[i] }; lsn == listener && callback == on_event)
+        if (events[i].listener == listener && events[i].callback == on_event)
         {
-            LOG_TRACE("Unregistered event {}", event_names[code - 1]);
-            events.erase_unordered(i);
+            LOG_TRACE("Unregistered event {}", event_name(code));
+            events.erase(i); // Keeps the dispatch order of the rest
             return true;
         }
     }
@@ -123,12 +341,41 @@ bool fire(u16 code, void* sender, void* data)
     if (!is_initialized)
         return false;
 
-    utl::vector<registered_event>& events = registered[code].events;
+    if (recorder::blocks_live_fire(code, data))
+        return false;
+
+    recorder::record_fire(code, data);
+
+    event_code_entry* entry{ find_entry(code, false) };
+    if (!entry)
+        return false;
+
+    recorder::scoped_suppress suppress{};
+    ++entry->stats.fires;
+    utl::vector<registered_event>& events = entry->events;
     for (u64 i = 0; i < events.size(); ++i)
     {
-        if (auto [listener, callback]{ events[i] }; callback(code, sender, listener, data))
+        const registered_event evt{ events[i] };
+        const f64              start{ stats_enabled ? now() : 0.0 };
+        const bool             handled{ evt.callback(code, sender, evt.listener, data) };
+
+        // The callback may have unregistered itself, so only count it if it's still where it was
+        if (i < events.size() && events[i].callback == evt.callback)
+        {
+            ++events[i].invocations;
+            if (stats_enabled)
+            {
+                const f64 elapsed{ now() - start };
+                events[i].time += elapsed;
+                entry->stats.time += elapsed;
+            }
+        }
+        ++entry->stats.invocations;
+
+        if (handled)
         {
             // If a listener "handled" an event, don't let remaining listeners handle as well
+            ++entry->stats.consumed;
             return true;
         }
     }
@@ -136,4 +383,311 @@ bool fire(u16 code, void* sender, void* data)
     return false;
 }
 
+event_stats get_stats(u16 code)
+{
+    const event_code_entry* entry{ find_entry(code, false) };
+    return entry ? entry->stats : event_stats{};
+}
+
+u32 get_listener_stats(u16 code, listener_stats* out, u32 max)
+{
+    const event_code_entry* entry{ find_entry(code, false) };
+    if (!entry)
+        return 0;
+
+    const u32 count{ (u32) entry->events.size() };
+    for (u32 i = 0; i < count && i < max; ++i)
+    {
+        const registered_event& evt{ entry->events[i] };
+        out[i] = { evt.listener, evt.callback, evt.priority, evt.invocations, evt.time };
+    }
+    return count;
+}
+
+void enable_stats(bool enable)
+{
+    stats_enabled = enable;
+}
+
+void reset_stats()
+{
+    auto reset = [](event_code_entry& entry) {
+        entry.stats = {};
+        for (auto& evt : entry.events)
+        {
+            evt.invocations = 0;
+            evt.time        = 0.0;
+        }
+    };
+
+    for (auto& entry : system_codes)
+        reset(entry);
+    for (event_code_entry* entry : user_codes)
+        reset(*entry);
+}
+
+bool post(u16 code, void* sender, const void* data, u32 size)
+{
+    if (!is_initialized)
+        return false;
+
+    if (size > max_payload_size)
+    {
+        LOG_ERROR("Event payload of {} bytes is too large to queue (max {})", size, max_payload_size);
+        return false;
+    }
+
+    if (recorder::blocks_live_event(code))
+        return false;
+
+    recorder::record_post(code, data, size);
+
+    utl::vector<queued_event>& queue{ queues[posting_queue] };
+    coalesce_rule*             rule{ find_rule(code) };
+    if (rule && rule->pending != u32_invalid)
+    {
+        queued_event& evt{ queue[rule->pending] };
+        evt.sender = sender;
+        if (rule->mode == coalesce::accumulate)
+        {
+            rule->accumulate(evt.payload, data);
+        } else
+        {
+            evt.size = (u16) size;
+            if (size)
+                memcpy(evt.payload, data, size);
+        }
+        return true;
+    }
+
+    if (rule)
+        rule->pending = (u32) queue.size();
+
+    queued_event& evt{ queue.emplace_back() };
+    evt.sender = sender;
+    evt.code   = code;
+    evt.size   = (u16) size;
+    if (size)
+        memcpy(evt.payload, data, size);
+
+    return true;
+}
+
+bool set_coalescing(u16 code, coalesce::mode mode, func_accumulate accumulate)
+{
+    if (!is_initialized)
+        return false;
+
+    if (mode == coalesce::accumulate && !accumulate)
+    {
+        LOG_ERROR("Accumulating {} events needs an accumulate function", event_name(code));
+        return false;
+    }
+
+    coalesce_rule* rule{ find_rule(code) };
+    if (mode == coalesce::none)
+    {
+        for (u32 i = 0; i < coalesce_rules.size(); ++i)
+        {
+            if (coalesce_rules[i].code == code)
+            {
+                coalesce_rules.erase_unordered(i);
+                break;
+            }
+        }
+        return true;
+    }
+
+    if (!rule)
+        rule = &coalesce_rules.emplace_back(coalesce_rule{ code, mode, accumulate, u32_invalid });
+
+    // Whatever is already queued stays as it is
+    rule->mode       = mode;
+    rule->accumulate = accumulate;
+    rule->pending    = u32_invalid;
+    return true;
+}
+
+bool post_from_thread(u16 code, void* sender, const void* data, u32 size)
+{
+    const ring_user user{};
+    ring_cell*      ring{ user.ring() };
+    if (!ring || size > max_payload_size)
+        return false;
+
+    u64        pos{ ring_head.load(std::memory_order_relaxed) };
+    ring_cell* cell{};
+    for (;;)
+    {
+        cell = &ring[pos & (thread_ring_size - 1)];
+        const u64 sequence{ cell->sequence.load(std::memory_order_acquire) };
+        const i64 diff{ (i64) sequence - (i64) pos };
+        if (diff == 0)
+        {
+            if (ring_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0)
+        {
+            // The main thread hasn't drained this lap yet
+            return false;
+        } else
+        {
+            pos = ring_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->evt.sender = sender;
+    cell->evt.code   = code;
+    cell->evt.size   = (u16) size;
+    if (size)
+        memcpy(cell->evt.payload, data, size);
+
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void dispatch_queued()
+{
+    if (!is_initialized)
+        return;
+
+    // Everything dispatched here was recorded when it was posted
+    recorder::scoped_suppress suppress{};
+
+    // Move whatever other threads posted into the queue, so it's coalesced and dispatched with everything else
+    ring_cell* ring{ thread_ring.load(std::memory_order_relaxed) };
+    for (;;)
+    {
+        ring_cell& cell{ ring[ring_tail & (thread_ring_size - 1)] };
+        if (cell.sequence.load(std::memory_order_acquire) != ring_tail + 1)
+            break;
+
+        post(cell.evt.code, cell.evt.sender, cell.evt.payload, cell.evt.size);
+        cell.sequence.store(ring_tail + thread_ring_size, std::memory_order_release);
+        ++ring_tail;
+    }
+
+    utl::vector<queued_event>& queue{ queues[posting_queue] };
+    if (queue.empty())
+        return;
+
+    posting_queue ^= 1;
+    for (auto& rule : coalesce_rules)
+        rule.pending = u32_invalid;
+
+    dispatch_order.clear();
+    for (const auto& evt : queue)
+    {
+        bool seen = false;
+        for (const u16 code : dispatch_order)
+        {
+            if (code == evt.code)
+            {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen)
+            dispatch_order.push_back(evt.code);
+    }
+
+    for (const u16 code : dispatch_order)
+    {
+        for (auto& evt : queue)
+        {
+            if (evt.code == code)
+                fire(code, evt.sender, evt.size ? evt.payload : nullptr);
+        }
+    }
+
+    queue.clear();
+}
+
+u32 queued_count()
+{
+    return (u32) queues[posting_queue].size();
+}
+
+bool unsubscribe(subscription sub)
+{
+    if (sub.type >= typed_events.size())
+        return false;
+
+    typed_event_entry& entry{ *typed_events[sub.type] };
+    for (u32 i = 0; i < entry.listeners.size(); ++i)
+    {
+        detail::typed_listener& listener{ entry.listeners[i] };
+        if (listener.id != sub.id || !listener.invoke)
+            continue;
+
+        // Erasing would shift the listeners an emit in progress is walking, so it only skips this one from now on
+        if (entry.emitting)
+        {
+            listener.invoke = nullptr;
+            entry.has_dead  = true;
+        } else
+        {
+            entry.listeners.erase(i);
+        }
+        return true;
+    }
+    return false;
+}
+
+namespace detail
+{
+u32 typed_event_id(const utl::type_key& key)
+{
+    for (u32 i = 0; i < typed_events.size(); ++i)
+    {
+        if (utl::same_type(typed_events[i]->key, key))
+            return i;
+    }
+
+    typed_events.push_back(new typed_event_entry{ key, {}, 0, false });
+    return (u32) typed_events.size() - 1;
+}
+
+u32 add_typed_listener(u32 type, const typed_listener& listener)
+{
+    sky_assert(type < typed_events.size());
+    typed_listener& added{ typed_events[type]->listeners.emplace_back(listener) };
+    added.id = next_listener_id++;
+    return added.id;
+}
+
+const typed_listener* begin_emit(u32 type, u32& count)
+{
+    if (type >= typed_events.size())
+    {
+        count = 0;
+        return nullptr;
+    }
+
+    typed_event_entry& entry{ *typed_events[type] };
+    ++entry.emitting;
+    count = (u32) entry.listeners.size();
+    return entry.listeners.data();
+}
+
+void end_emit(u32 type)
+{
+    if (type >= typed_events.size())
+        return;
+
+    typed_event_entry& entry{ *typed_events[type] };
+    if (--entry.emitting || !entry.has_dead)
+        return;
+
+    u32 alive{};
+    for (u32 i = 0; i < entry.listeners.size(); ++i)
+    {
+        if (entry.listeners[i].invoke)
+            entry.listeners[alive++] = entry.listeners[i];
+    }
+    entry.listeners.resize(alive);
+    entry.has_dead = false;
+}
+} // namespace detail
+
 } // namespace sky::events
\ No newline at end of file
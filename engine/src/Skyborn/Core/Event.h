@@ -23,6 +23,11 @@
 // ------------------------------------------------------------------------------
 #pragma  once
 #include "Skyborn/Defines.h"
+#include "Skyborn/Util/Util.h"
+
+#include <cstring>
+#include <type_traits>
+#include <typeinfo>
 
 
 namespace sky::events
@@ -95,6 +100,28 @@ struct system_event
 
 using func_on_event = bool (*)(u16 code, void* sender, void* listener, void* data);
 
+// Largest payload post can copy into the queue
+constexpr u32 max_payload_size = 16;
+
+// How post treats an event whose code is already waiting in the queue
+struct coalesce
+{
+    enum mode : u8
+    {
+        // Every post is queued
+        none,
+
+        // The queued event takes the new payload and sender
+        last_value,
+
+        // The new payload is combined into the queued one with the code's accumulate function
+        accumulate,
+    };
+};
+
+// Combines a newly posted payload (from) into the queued one (into)
+using func_accumulate = void (*)(void* into, const void* from);
+
 bool initialize();
 void shutdown();
 
@@ -103,9 +130,10 @@ void shutdown();
  * @param code The event code to listen for
  * @param listener A pointer to the listener. Can be null
  * @param on_event The callback function that will be invoked with the event is fired
+ * @param priority Higher priorities are called first. Equal priorities are called in registration order
  * @return true if the event was registered, false otherwise
  */
-SAPI bool register_event(u16 code, void* listener, func_on_event on_event);
+SAPI bool register_event(u16 code, void* listener, func_on_event on_event, i32 priority = 0);
 
 
 /**
@@ -126,4 +154,168 @@ SAPI bool unregister_event(u16 code, void* listener, func_on_event on_event);
  */
 SAPI bool fire(u16 code, void* sender, void* data);
 
+struct event_stats
+{
+    u64 fires{};
+    u64 invocations{}; // Listener calls
+    u64 consumed{};    // Fires a listener handled
+    f64 time{};        // Seconds spent in listeners
+};
+
+struct listener_stats
+{
+    void*         listener{};
+    func_on_event callback{};
+    i32           priority{};
+    u64           invocations{};
+    f64           time{};
+};
+
+// Counters for fire on a code, including fires from dispatch_queued. All zero if nothing listens to it
+[[nodiscard]] SAPI event_stats get_stats(u16 code);
+
+/**
+ * Per listener counters of a code, in dispatch order
+ * @param out Receives up to max entries
+ * @return The number of listeners registered for the code, which may be more than max
+ */
+SAPI u32 get_listener_stats(u16 code, listener_stats* out, u32 max);
+
+// Timing listeners costs two clock reads per call. Enabled by default
+SAPI void enable_stats(bool enable);
+
+SAPI void reset_stats();
+
+/**
+ * Queues an event to be fired by the next dispatch_queued instead of right away. The payload is copied into the
+ * queue, so data doesn't need to outlive the call
+ * @param code The event code to post
+ * @param sender A pointer to the sender. Can be null
+ * @param data Event data. Can be null
+ * @param size Size of data in bytes, at most max_payload_size
+ * @return true if queued, false otherwise
+ */
+SAPI bool post(u16 code, void* sender, const void* data, u32 size);
+
+/**
+ * Fires every queued event, grouped by code in the order each code was first posted. Events within a code keep
+ * their posting order. Events posted by listeners during dispatch are queued for the next dispatch
+ */
+SAPI void dispatch_queued();
+
+/**
+ * Sets how posted events of a code are coalesced, so listeners see at most one of them per dispatch.
+ * mouse_moved and resized default to last_value, mouse_wheel to accumulate (summing the deltas)
+ * @param code The event code
+ * @param mode The coalescing mode
+ * @param accumulate Required for coalesce::accumulate, ignored otherwise
+ * @return true if set, false otherwise
+ */
+SAPI bool set_coalescing(u16 code, coalesce::mode mode, func_accumulate accumulate = nullptr);
+
+/**
+ * Thread safe version of post, for use off the main thread. Lock free: events go into a bounded multi-producer ring
+ * that the next dispatch_queued drains into the queue, keeping each thread's posting order. May race with shutdown,
+ * which waits for posts in progress, after which posting fails
+ * @return true if queued, false if the ring is full, the payload too large or events aren't initialized
+ */
+SAPI bool post_from_thread(u16 code, void* sender, const void* data, u32 size);
+
+// Number of events waiting for the next dispatch
+[[nodiscard]] SAPI u32 queued_count();
+
+// Typed events. Each event type has its own listener list and payloads are passed by reference. Handlers are stored
+// inline, so subscribing never allocates, and each is called through a thunk the handler itself is inlined into
+
+// Largest capture a typed handler may have
+constexpr u32 max_handler_size = 16;
+
+struct subscription
+{
+    u32 type{ u32_invalid };
+    u32 id{ u32_invalid };
+
+    [[nodiscard]] constexpr bool is_valid() const { return id != u32_invalid; }
+};
+
+namespace detail
+{
+struct typed_listener
+{
+    bool (*invoke)(const void* handler, const void* event); // nullptr once unsubscribed during an emit
+    u32 id;
+    alignas(8) u8 handler[max_handler_size];
+};
+
+SAPI u32 typed_event_id(const utl::type_key& key);
+SAPI u32 add_typed_listener(u32 type, const typed_listener& listener);
+SAPI const typed_listener* begin_emit(u32 type, u32& count);
+SAPI void                  end_emit(u32 type);
+
+// Ids agree across the DLL boundary, see utl::type_key
+template<typename E>
+u32 event_type_id()
+{
+    static const u32 id{ typed_event_id(utl::type_key_of<E>()) };
+    return id;
+}
+
+template<typename E, typename F>
+bool invoke(const void* handler, const void* event)
+{
+    const F& func{ *(const F*) handler };
+    if constexpr (std::is_same_v<std::invoke_result_t<const F&, const E&>, bool>)
+    {
+        return func(*(const E*) event);
+    } else
+    {
+        func(*(const E*) event);
+        return false;
+    }
+}
+} // namespace detail
+
+/**
+ * Subscribes a handler to events of type E. Handlers take (const E&) and return bool (true if handled, which stops
+ * the event from reaching later handlers) or void
+ * @param func Any trivially copyable callable of up to max_handler_size bytes, e.g. a lambda capturing a pointer
+ * @return Handle for unsubscribe
+ */
+template<typename E, typename F>
+subscription subscribe(F func)
+{
+    static_assert(std::is_trivially_copyable_v<F> && sizeof(F) <= max_handler_size && alignof(F) <= 8,
+                  "Handlers are stored inline. Capture a pointer to larger state instead");
+    static_assert(std::is_invocable_v<const F&, const E&>, "Handler must take (const E&)");
+
+    detail::typed_listener listener{ &detail::invoke<E, F>, u32_invalid, {} };
+    memcpy(listener.handler, &func, sizeof(F));
+
+    const u32 type{ detail::event_type_id<E>() };
+    return { type, detail::add_typed_listener(type, listener) };
+}
+
+SAPI bool unsubscribe(subscription sub);
+
+/**
+ * Calls every handler subscribed to E, in subscription order, until one handles it.
+ * Handlers may unsubscribe from E, which takes effect right away, but must not subscribe to E while it is being emitted
+ * @return true if handled, false otherwise
+ */
+template<typename E>
+bool emit(const E& event)
+{
+    const u32   type{ detail::event_type_id<E>() };
+    u32         count{};
+    const auto* listeners{ detail::begin_emit(type, count) };
+    bool        handled{ false };
+    for (u32 i = 0; i < count && !handled; ++i)
+    {
+        if (listeners[i].invoke)
+            handled = listeners[i].invoke(listeners[i].handler, &event);
+    }
+    detail::end_emit(type);
+    return handled;
+}
+
 } // namespace sky::events
\ No newline at end of file
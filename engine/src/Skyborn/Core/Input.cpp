@@ -22,41 +22,69 @@
 //
 // ------------------------------------------------------------------------------
 
+#define SKY_LOG_CATEGORY input
+
 #include "Input.h"
 
 #include "Event.h"
+#include "Platform.h"
+#include "Recorder.h"
 #include "Skyborn/Debug/Logger.h"
+#include "Skyborn/Util/Maths.h"
 
 namespace sky::input
 {
 namespace
 {
-constexpr u16 max_keys       = 256;
-bool          is_initialized = false;
+constexpr u32 max_samples = 512;
 
-struct keyboard
+// Transitions since the last latch, so a press and release between two frames still shows up as both
+struct edges
 {
-    bool keys[max_keys]{};
+    key_bits keys_down{};
+    key_bits keys_up{};
+    u32      buttons_down{};
+    u32      buttons_up{};
 };
 
-struct mouse
+// Filled by process_* while the other one is read as the frame's samples
+struct sample_buffer
 {
-    i16  x{};
-    i16  y{};
-    bool buttons[button::max_buttons]{};
+    input_sample samples[max_samples];
+    u32          count;
 };
 
-keyboard current_keyboard{};
-keyboard previous_keyboard{};
+bool          is_initialized = false;
+input_state   current{};
+edges         pending{};
+sample_buffer sample_buffers[2]{};
+u32           receiving{};
+u32           dropped_samples{};
+latency_stats latency{};
+
+void add_sample(input_sample::kind::type type, u16 code, bool pressed, i16 x, i16 y)
+{
+    sample_buffer& buffer{ sample_buffers[receiving] };
+    if (buffer.count == max_samples)
+    {
+        ++dropped_samples;
+        return;
+    }
 
-mouse current_mouse{};
-mouse previous_mouse{};
+    buffer.samples[buffer.count++] = { platform::get_time(), code, type, pressed, x, y };
+}
 
 } // anonymous namespace
 
 bool initialize()
 {
-    is_initialized = true;
+    current                 = {};
+    pending                 = {};
+    latency                 = {};
+    receiving               = 0;
+    sample_buffers[0].count = 0;
+    sample_buffers[1].count = 0;
+    is_initialized          = true;
     LOG_INFO("Input submodule initialized");
 
     return true;
@@ -68,24 +96,67 @@ void shutdown()
     LOG_INFO("Input submodule shutdown");
 }
 
+void latch()
+{
+    if (!is_initialized)
+        return;
+
+    current.pressed_keys     = pending.keys_down;
+    current.released_keys    = pending.keys_up;
+    current.pressed_buttons  = pending.buttons_down;
+    current.released_buttons = pending.buttons_up;
+    pending                  = {};
+
+    if (dropped_samples)
+    {
+        LOG_WARN("Dropped {} input samples this frame (max {})", dropped_samples, max_samples);
+        dropped_samples = 0;
+    }
+
+    receiving ^= 1;
+    sample_buffers[receiving].count = 0;
+}
+
+void presented(f64 time)
+{
+    const sample_buffer& frame{ sample_buffers[receiving ^ 1] };
+    if (!is_initialized || !frame.count)
+        return;
+
+    latency.last = time - frame.samples[0].time;
+    latency.max  = math::max(latency.max, latency.last);
+    ++latency.frames;
+    latency.average += (latency.last - latency.average) / (f64) latency.frames;
+}
+
 void update(f64 delta)
 {
     if (!is_initialized)
         return;
 
-    previous_keyboard = current_keyboard;
-    previous_mouse    = current_mouse;
-    // memcpy(&previous_keyboard, &current_keyboard, sizeof(keyboard));
-    // memcpy(&previous_mouse, &current_mouse, sizeof(keyboard));
+    current.previous_keys    = current.keys;
+    current.previous_buttons = current.buttons;
+    current.previous_x       = current.x;
+    current.previous_y       = current.y;
 }
 
 void process_key(key::code key, bool pressed)
 {
     // No need to handle if the state hasn't changed
-    if (current_keyboard.keys[key] == pressed)
+    if (recorder::blocks_live_input() || current.keys.test(key) == pressed)
         return;
 
-    current_keyboard.keys[key] = pressed; // update internal state
+    recorder::record_key(key, pressed);
+    recorder::scoped_suppress suppress{};
+
+    add_sample(input_sample::kind::key, key, pressed, current.x, current.y);
+
+    // update internal state
+    current.keys.set(key, pressed);
+    if (pressed)
+        pending.keys_down.set(key, true);
+    else
+        pending.keys_up.set(key, true);
 
     // Invoke event for processing
     u16 code = (u16) key;
@@ -95,10 +166,24 @@ void process_key(key::code key, bool pressed)
 void process_button(button::code btn, bool pressed)
 {
     // No need to handle if the state hasn't changed
-    if (current_mouse.buttons[btn] == pressed)
+    if (recorder::blocks_live_input() || current.button_down(btn) == pressed)
         return;
 
-    current_mouse.buttons[btn] = pressed; // update internal state
+    recorder::record_button(btn, pressed);
+    recorder::scoped_suppress suppress{};
+
+    add_sample(input_sample::kind::button, btn, pressed, current.x, current.y);
+
+    // update internal state
+    if (pressed)
+    {
+        current.buttons |= 1u << btn;
+        pending.buttons_down |= 1u << btn;
+    } else
+    {
+        current.buttons &= ~(1u << btn);
+        pending.buttons_up |= 1u << btn;
+    }
 
     // Invoke event for processing
     u16 code = (u16) btn;
@@ -109,91 +194,79 @@ void process_button(button::code btn, bool pressed)
 void process_mouse_move(i16 x, i16 y)
 {
     // No need to handle if the state hasn't changed
-    if (current_mouse.x == x && current_mouse.y == y)
+    if (recorder::blocks_live_input() || (current.x == x && current.y == y))
         return;
 
+    recorder::record_mouse_move(x, y);
+    recorder::scoped_suppress suppress{};
+
+    add_sample(input_sample::kind::mouse_move, 0, false, x, y);
+
 #if 0
     LOG_TRACE("Mouse Pos: ({}, {})", x, y);
 #endif
 
     // Update internal state
-    current_mouse.x = x;
-    current_mouse.y = y;
+    current.x = x;
+    current.y = y;
 
-    // Invoke event for processing
+    // Queued, since the platform can report many moves per frame
     u32 data = 0;
     SET_BITS(data, 1, 16, x);
     SET_BITS(data, 17, 16, y);
-    events::fire(events::system_event::mouse_moved, nullptr, &data);
+    events::post(events::system_event::mouse_moved, nullptr, &data, sizeof(data));
 }
 
 void process_mouse_wheel(i8 delta)
 {
-    events::fire(events::system_event::mouse_wheel, nullptr, &delta);
+    if (recorder::blocks_live_input())
+        return;
+
+    recorder::record_mouse_wheel(delta);
+    recorder::scoped_suppress suppress{};
+
+    add_sample(input_sample::kind::mouse_wheel, 0, false, delta, 0);
+    events::post(events::system_event::mouse_wheel, nullptr, &delta, sizeof(delta));
 }
 
 bool key_down(key::code key)
 {
-    if (!is_initialized)
-        return false;
-
-    return current_keyboard.keys[key];
+    return is_initialized && current.key_down(key);
 }
 
 bool key_up(key::code key)
 {
-    if (!is_initialized)
-        return true;
-
-    return !current_keyboard.keys[key];
+    return !is_initialized || !current.key_down(key);
 }
 
 bool was_key_down(key::code key)
 {
-    if (!is_initialized)
-        return false;
-
-    return previous_keyboard.keys[key];
+    return is_initialized && current.previous_keys.test(key);
 }
 
 bool was_key_up(key::code key)
 {
-    if (!is_initialized)
-        return true;
-
-    return !previous_keyboard.keys[key];
+    return !is_initialized || !current.previous_keys.test(key);
 }
 
 bool button_down(button::code btn)
 {
-    if (!is_initialized)
-        return false;
-
-    return current_mouse.buttons[btn];
+    return is_initialized && current.button_down(btn);
 }
 
 bool button_up(button::code btn)
 {
-    if (!is_initialized)
-        return true;
-
-    return !current_mouse.buttons[btn];
+    return !is_initialized || !current.button_down(btn);
 }
 
 bool was_button_down(button::code btn)
 {
-    if (!is_initialized)
-        return false;
-
-    return previous_mouse.buttons[btn];
+    return is_initialized && ((current.previous_buttons >> btn) & 1);
 }
 
 bool was_button_up(button::code btn)
 {
-    if (!is_initialized)
-        return true;
-
-    return !previous_mouse.buttons[btn];
+    return !is_initialized || !((current.previous_buttons >> btn) & 1);
 }
 
 void get_mouse_position(i32* x, i32* y)
@@ -205,8 +278,8 @@ void get_mouse_position(i32* x, i32* y)
         return;
     }
 
-    *x = current_mouse.x;
-    *y = current_mouse.y;
+    *x = current.x;
+    *y = current.y;
 }
 
 void get_previous_mouse_position(i32* x, i32* y)
@@ -218,8 +291,30 @@ void get_previous_mouse_position(i32* x, i32* y)
         return;
     }
 
-    *x = previous_mouse.x;
-    *y = previous_mouse.y;
+    *x = current.previous_x;
+    *y = current.previous_y;
+}
+
+const input_state& state()
+{
+    return current;
+}
+
+const input_sample* frame_samples(u32& count)
+{
+    const sample_buffer& frame{ sample_buffers[receiving ^ 1] };
+    count = is_initialized ? frame.count : 0;
+    return frame.samples;
+}
+
+latency_stats get_latency_stats()
+{
+    return latency;
+}
+
+void reset_latency_stats()
+{
+    latency = {};
 }
 
 } // namespace sky::input
\ No newline at end of file
@@ -178,9 +178,91 @@ struct key
     };
 };
 
+// One bit per key, so edges and bindings are a handful of word-wide operations
+struct key_bits
+{
+    u64 words[4]{};
+
+    [[nodiscard]] constexpr bool test(u16 k) const { return (words[(k >> 6) & 3] >> (k & 63)) & 1; }
+
+    constexpr void set(u16 k, bool value)
+    {
+        const u64 bit{ 1ull << (k & 63) };
+        words[(k >> 6) & 3] = value ? words[(k >> 6) & 3] | bit : words[(k >> 6) & 3] & ~bit;
+    }
+
+    [[nodiscard]] constexpr bool intersects(const key_bits& o) const
+    {
+        return ((words[0] & o.words[0]) | (words[1] & o.words[1]) | (words[2] & o.words[2]) |
+                (words[3] & o.words[3])) != 0;
+    }
+};
+
+// Everything polled about the keyboard and mouse this frame. Get it once with input::state() and query it inline
+struct input_state
+{
+    key_bits keys{};          // Down now
+    key_bits previous_keys{}; // Down at the end of last frame
+    key_bits pressed_keys{};  // Went down since last frame, even if it has gone back up
+    key_bits released_keys{}; // Went up since last frame, even if it has gone back down
+    u32      buttons{};       // One bit per button::code
+    u32      previous_buttons{};
+    u32      pressed_buttons{};
+    u32      released_buttons{};
+    i16      x{};
+    i16      y{};
+    i16      previous_x{};
+    i16      previous_y{};
+
+    [[nodiscard]] constexpr bool key_down(key::code k) const { return keys.test(k); }
+    [[nodiscard]] constexpr bool key_pressed(key::code k) const { return pressed_keys.test(k); }
+    [[nodiscard]] constexpr bool key_released(key::code k) const { return released_keys.test(k); }
+
+    [[nodiscard]] constexpr bool button_down(button::code b) const { return (buttons >> b) & 1; }
+    [[nodiscard]] constexpr bool button_pressed(button::code b) const { return (pressed_buttons >> b) & 1; }
+    [[nodiscard]] constexpr bool button_released(button::code b) const { return (released_buttons >> b) & 1; }
+};
+
+// One raw input message, stamped when the platform handed it over
+struct input_sample
+{
+    struct kind
+    {
+        enum type : u8
+        {
+            key,
+            button,
+            mouse_move,
+            mouse_wheel,
+        };
+    };
+
+    f64 time; // platform::get_time() when it was received
+    u16 code; // key::code or button::code
+    u8  type;
+    u8  pressed;
+    i16 x; // Mouse position, or the wheel delta in x
+    i16 y;
+};
+
+struct latency_stats
+{
+    f64 last{};    // Seconds from the oldest input sample of the last frame with input to its present
+    f64 average{}; // Over every frame with input since the last reset
+    f64 max{};
+    u64 frames{};
+};
+
 bool initialize();
 void shutdown();
 
+// Works out this frame's pressed and released edges and hands over the samples received since the last latch.
+// Called once the frame's input has been processed
+void latch();
+
+// Called once the frame that consumed the latched samples has been presented
+void presented(f64 time);
+
 void update(f64 delta);
 
 void process_key(key::code key, bool pressed);
@@ -203,4 +285,18 @@ SAPI bool was_button_up(button::code btn);
 SAPI void get_mouse_position(i32* x, i32* y);
 SAPI void get_previous_mouse_position(i32* x, i32* y);
 
+// The whole input state, for polling many keys or actions without a call per query
+[[nodiscard]] SAPI const input_state& state();
+
+/**
+ * Every input sample received before this frame, in the order the platform reported them. Unlike the polled state,
+ * a key pressed and released between two frames shows up here as both
+ * @param count Set to the number of samples
+ * @return The samples. Valid until the next frame
+ */
+SAPI const input_sample* frame_samples(u32& count);
+
+[[nodiscard]] SAPI latency_stats get_latency_stats();
+SAPI void reset_latency_stats();
+
 } // namespace sky::input
\ No newline at end of file
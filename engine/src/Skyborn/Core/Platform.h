@@ -41,6 +41,10 @@ namespace sky::platform
 #ifdef _WIN64
 using window_handle   = HWND;
 using window_instance = HINSTANCE;
+#else
+// Headless backends have no native window
+using window_handle   = void*;
+using window_instance = void*;
 #endif
 
 SAPI bool initialize(const char* app_name, i32 x, i32 y, u32 width, u32 height);
@@ -54,10 +58,58 @@ void reset_console();
 
 SAPI f64 get_time();
 
+// A file mapped into memory. Stores into a writable mapping reach the file through the page cache, with no syscall,
+// and are kept even if the process crashes
+struct mapped_file
+{
+    u8*   data{};
+    u64   size{};
+    void* file{};    // Native file handle
+    void* mapping{}; // Native mapping handle, where the platform has one
+    bool  writable{};
+};
+
+/**
+ * Maps a file into memory
+ * @param path The file
+ * @param size Read only, how much of the file to map, 0 for all of it. Writable, the file is created or emptied and
+ * preallocated to this many bytes
+ * @param writable Map for writing as well as reading
+ * @param file Receives the mapping. An empty read only file maps to no data
+ * @return true if the file was mapped, false otherwise
+ */
+SAPI bool map_file(const char* path, u64 size, bool writable, mapped_file& file);
+
+// Unmaps and closes the file. A writable file is cut down to its first used bytes, unless used is u64_invalid
+SAPI void unmap_file(mapped_file& file, u64 used = u64_invalid);
+
+// How a mapping is about to be read, so the OS can read ahead or drop pages to suit
+struct map_advice
+{
+    enum advice : u8
+    {
+        normal,
+        sequential, // Read ahead aggressively, pages behind can go
+        random,     // Don't read ahead
+        will_need,  // Start reading the range in now
+        dont_need,  // The range can be dropped from memory; it's read in again if touched
+    };
+};
+
+// Hints how a range of a mapping will be used. size 0 means to the end. Returns false if the hint wasn't taken
+SAPI bool advise_mapped(const mapped_file& file, u64 offset, u64 size, map_advice::advice advice);
+
+// Starts writing a writable mapping's dirty pages back to the file. With wait, returns once they're on disk
+SAPI bool flush_mapped(const mapped_file& file, bool wait);
+
 window_handle   get_window_handle();
 window_instance get_window_instance();
 
 SAPI u32 get_window_width();
 SAPI u32 get_window_height();
 
+// Resizes the window's client area, firing a resized event. Headless backends resize their fake window,
+// whose initial size comes from the application description or SKY_WINDOW_SIZE=<width>x<height> if set
+SAPI void set_window_size(u32 width, u32 height);
+
 } // namespace sky::platform
\ No newline at end of file
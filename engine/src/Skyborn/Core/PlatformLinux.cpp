@@ -0,0 +1,300 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: PlatformLinux.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#define SKY_LOG_CATEGORY platform
+
+#include "Platform.h"
+
+#ifndef SKY_PLATFORM_LINUX
+    #error This file should only be compiled on Linux
+#endif
+
+#include "Skyborn/Debug/Logger.h"
+#include "Event.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sky::platform
+{
+
+namespace
+{
+// trace, debug, info, warn, error, fatal
+constexpr const char* levels[6]{ "\033[90m", "\033[37m", "\033[32m", "\033[33m", "\033[91m", "\033[35m" };
+constexpr const char* reset_color{ "\033[0m" };
+
+struct platform_state
+{
+    bool color_out;
+    bool color_err;
+    u32  width;
+    u32  height;
+} plat_state;
+
+volatile sig_atomic_t quit_requested = 0;
+
+void on_signal(i32)
+{
+    quit_requested = 1;
+}
+
+void post_resized()
+{
+    u32 data = 0;
+    SET_BITS(data, 1, 16, plat_state.width);
+    SET_BITS(data, 17, 16, plat_state.height);
+    events::post(events::system_event::resized, nullptr, &data, sizeof(data));
+}
+
+void write_console(i32 fd, bool color, const char* msg, u8 level)
+{
+    if (color)
+    {
+        char      buffer[4096];
+        const i32 length = snprintf(buffer, sizeof(buffer), "%s%s%s", levels[level], msg, reset_color);
+        if (length > 0 && length < (i32) sizeof(buffer))
+        {
+            [[maybe_unused]] auto r = ::write(fd, buffer, (u64) length);
+            return;
+        }
+    }
+
+    [[maybe_unused]] auto r = ::write(fd, msg, strlen(msg));
+}
+
+} // anonymous namespace
+
+bool initialize(const char* app_name, i32 x, i32 y, u32 width, u32 height)
+{
+    LOG_INFO("Booting up Skyborn platform (headless)");
+    plat_state.color_out = isatty(STDOUT_FILENO);
+    plat_state.color_err = isatty(STDERR_FILENO);
+
+    plat_state.width  = width;
+    plat_state.height = height;
+    if (const char* size = getenv("SKY_WINDOW_SIZE"))
+    {
+        u32 w = 0;
+        u32 h = 0;
+        if (sscanf(size, "%ux%u", &w, &h) == 2)
+        {
+            plat_state.width  = w;
+            plat_state.height = h;
+        } else
+        {
+            LOG_WARN("Ignoring malformed SKY_WINDOW_SIZE '{}'. Expected <width>x<height>", size);
+        }
+    }
+
+    // Ctrl+C or a supervisor's SIGTERM shuts down cleanly instead of killing the process mid-frame
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    LOG_INFO("Headless window '{}' created ({}x{})", app_name ? app_name : "", plat_state.width, plat_state.height);
+
+    // A real window reports its size once it is shown
+    post_resized();
+    return true;
+}
+
+void shutdown()
+{
+    LOG_INFO("Platform shutting down");
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    reset_console();
+    LOG_INFO("Platform has shutdown");
+}
+
+bool pump_messages()
+{
+    if (quit_requested)
+    {
+        quit_requested = 0;
+        events::fire(events::system_event::application_quit, nullptr, nullptr);
+    }
+
+    return true;
+}
+
+void write_message(const char* msg, u8 color)
+{
+    write_console(STDOUT_FILENO, plat_state.color_out, msg, color);
+}
+
+void write_error(const char* msg, u8 color)
+{
+    write_console(STDERR_FILENO, plat_state.color_err, msg, color);
+}
+
+void reset_console()
+{
+    if (plat_state.color_out)
+    {
+        [[maybe_unused]] auto r = ::write(STDOUT_FILENO, reset_color, strlen(reset_color));
+    }
+}
+
+f64 get_time()
+{
+    // MONOTONIC_RAW isn't slewed by NTP, so frame deltas stay consistent on long soak runs
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+    return (f64) now.tv_sec + (f64) now.tv_nsec * 1e-9;
+}
+
+bool map_file(const char* path, u64 size, bool writable, mapped_file& file)
+{
+    file = {};
+    if (writable && !size)
+    {
+        LOG_ERROR("A writable mapping of {} needs a size", path);
+        return false;
+    }
+
+    const i32 fd{ ::open(path, writable ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644) };
+    if (fd < 0)
+    {
+        LOG_ERROR("Failed to open {} for mapping", path);
+        return false;
+    }
+
+    u64 length{ size };
+    if (writable)
+    {
+        // Reserving the blocks up front means a full disk fails here, rather than as a SIGBUS on some later store
+        if (posix_fallocate(fd, 0, (off_t) size) != 0 && ftruncate(fd, (off_t) size) != 0)
+        {
+            LOG_ERROR("Failed to preallocate {} bytes for {}", size, path);
+            ::close(fd);
+            return false;
+        }
+    } else
+    {
+        struct stat info
+        {};
+        if (fstat(fd, &info) != 0)
+        {
+            LOG_ERROR("Failed to get the size of {}", path);
+            ::close(fd);
+            return false;
+        }
+        length = (u64) info.st_size;
+        if (size && size < length)
+            length = size;
+    }
+
+    if (!length)
+    {
+        ::close(fd);
+        return true;
+    }
+
+    void* data{ mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0) };
+    if (data == MAP_FAILED)
+    {
+        LOG_ERROR("Failed to map {}", path);
+        ::close(fd);
+        return false;
+    }
+
+    file.data     = (u8*) data;
+    file.size     = length;
+    file.file     = (void*) (intptr_t) fd;
+    file.writable = writable;
+    return true;
+}
+
+void unmap_file(mapped_file& file, u64 used)
+{
+    if (!file.data)
+        return;
+
+    munmap(file.data, file.size);
+    const i32 fd{ (i32) (intptr_t) file.file };
+    if (file.writable && used < file.size)
+    {
+        [[maybe_unused]] auto r = ftruncate(fd, (off_t) used);
+    }
+    ::close(fd);
+    file = {};
+}
+
+bool advise_mapped(const mapped_file& file, u64 offset, u64 size, map_advice::advice advice)
+{
+    if (!file.data || offset >= file.size)
+        return false;
+
+    constexpr i32 advices[]{ MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED };
+
+    // madvise wants a page aligned start
+    const u64 page{ (u64) sysconf(_SC_PAGESIZE) };
+    const u64 start{ offset & ~(page - 1) };
+    const u64 end{ size && size < file.size - offset ? offset + size : file.size };
+    return madvise(file.data + start, end - start, advices[advice]) == 0;
+}
+
+bool flush_mapped(const mapped_file& file, bool wait)
+{
+    if (!file.data || !file.writable)
+        return false;
+
+    return msync(file.data, file.size, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+window_handle get_window_handle()
+{
+    return nullptr;
+}
+
+window_instance get_window_instance()
+{
+    return nullptr;
+}
+
+u32 get_window_width()
+{
+    return plat_state.width;
+}
+
+u32 get_window_height()
+{
+    return plat_state.height;
+}
+
+void set_window_size(u32 width, u32 height)
+{
+    plat_state.width  = width;
+    plat_state.height = height;
+    post_resized();
+}
+
+} // namespace sky::platform
\ No newline at end of file
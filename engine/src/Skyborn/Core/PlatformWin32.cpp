@@ -22,6 +22,8 @@
 //
 // ------------------------------------------------------------------------------
 
+#define SKY_LOG_CATEGORY platform
+
 #include "Platform.h"
 
 #ifndef SKY_PLATFORM_WINDOWS
@@ -114,7 +116,7 @@ LRESULT CALLBACK process_messages(HWND hwnd, u32 msg, WPARAM wparam, LPARAM lpar
         u32 data = 0;
         SET_BITS(data, 1, 16, w);
         SET_BITS(data, 17, 16, h);
-        events::fire(events::system_event::resized, nullptr, &data);
+        events::post(events::system_event::resized, nullptr, &data, sizeof(data));
     }
     break;
     case WM_KEYDOWN:
@@ -346,6 +348,118 @@ f64 get_time()
     return (f64) now_time.QuadPart * plat_state.clock_frequency;
 }
 
+bool map_file(const char* path, u64 size, bool writable, mapped_file& file)
+{
+    file = {};
+    if (writable && !size)
+    {
+        LOG_ERROR("A writable mapping of {} needs a size", path);
+        return false;
+    }
+
+    HANDLE handle{ CreateFileA(path, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                               writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("Failed to open {} for mapping", path);
+        return false;
+    }
+
+    u64 length{ size };
+    if (!writable)
+    {
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(handle, &file_size))
+        {
+            LOG_ERROR("Failed to get the size of {}", path);
+            CloseHandle(handle);
+            return false;
+        }
+        length = (u64) file_size.QuadPart;
+        if (size && size < length)
+            length = size;
+    }
+
+    if (!length)
+    {
+        CloseHandle(handle);
+        return true;
+    }
+
+    // A writable mapping larger than the file grows the file to match, which preallocates it
+    HANDLE mapping{ CreateFileMappingA(handle, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, (DWORD) (length >> 32),
+                                       (DWORD) length, nullptr) };
+    void*  data{ mapping ? MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, (SIZE_T) length)
+                         : nullptr };
+    if (!data)
+    {
+        LOG_ERROR("Failed to map {}", path);
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(handle);
+        return false;
+    }
+
+    file.data     = (u8*) data;
+    file.size     = length;
+    file.file     = handle;
+    file.mapping  = mapping;
+    file.writable = writable;
+    return true;
+}
+
+void unmap_file(mapped_file& file, u64 used)
+{
+    if (!file.data)
+        return;
+
+    UnmapViewOfFile(file.data);
+    CloseHandle(file.mapping);
+    if (file.writable && used < file.size)
+    {
+        LARGE_INTEGER end{};
+        end.QuadPart = (LONGLONG) used;
+        SetFilePointerEx(file.file, end, nullptr, FILE_BEGIN);
+        SetEndOfFile(file.file);
+    }
+    CloseHandle(file.file);
+    file = {};
+}
+
+bool advise_mapped(const mapped_file& file, u64 offset, u64 size, map_advice::advice advice)
+{
+    if (!file.data || offset >= file.size)
+        return false;
+
+    const u64 length{ size && size < file.size - offset ? size : file.size - offset };
+    switch (advice)
+    {
+    case map_advice::will_need:
+    {
+        WIN32_MEMORY_RANGE_ENTRY range{ file.data + offset, (SIZE_T) length };
+        return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    case map_advice::dont_need:
+        // Clean pages of a file mapping are only dropped from the working set, not lost
+        return VirtualUnlock(file.data + offset, (SIZE_T) length) || GetLastError() == ERROR_NOT_LOCKED;
+    default:
+        // Windows reads ahead on its own and has no equivalent of the access pattern hints
+        return false;
+    }
+}
+
+bool flush_mapped(const mapped_file& file, bool wait)
+{
+    if (!file.data || !file.writable)
+        return false;
+
+    if (!FlushViewOfFile(file.data, 0))
+        return false;
+
+    return !wait || FlushFileBuffers(file.file);
+}
+
 window_handle get_window_handle()
 {
     return plat_state.hwnd;
@@ -366,4 +480,16 @@ u32 get_window_height()
     return plat_state.height;
 }
 
+void set_window_size(u32 width, u32 height)
+{
+    if (!plat_state.hwnd)
+        return;
+
+    RECT rect{ 0, 0, (LONG) width, (LONG) height };
+    AdjustWindowRectEx(&rect, (DWORD) GetWindowLongA(plat_state.hwnd, GWL_STYLE), false,
+                       (DWORD) GetWindowLongA(plat_state.hwnd, GWL_EXSTYLE));
+    SetWindowPos(plat_state.hwnd, nullptr, 0, 0, rect.right - rect.left, rect.bottom - rect.top,
+                 SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
 } // namespace sky::platform
\ No newline at end of file
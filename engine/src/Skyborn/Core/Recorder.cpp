@@ -0,0 +1,453 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Recorder.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Recorder.h"
+
+#include "Event.h"
+#include "Input.h"
+#include "Skyborn/Debug/Logger.h"
+#include "Skyborn/Util/FileSystem.h"
+#include "Skyborn/Util/Maths.h"
+#include "Skyborn/Util/Vector.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace sky::recorder
+{
+namespace
+{
+constexpr u32 file_magic   = 0x52594b53; // "SKYR"
+constexpr u32 file_version = 2;
+
+struct record_kind
+{
+    enum kind : u8
+    {
+        fire,
+        post,
+        key,
+        button,
+        mouse_move,
+        mouse_wheel,
+    };
+};
+
+struct file_header
+{
+    u32 magic;
+    u32 version;
+    u32 frame_count; // Set when recording stops
+};
+
+// Followed by size payload bytes. Records are packed back to back, so read them with memcpy
+struct record_header
+{
+    u32 frame;
+    f32 time; // Seconds since recording started
+    u16 code; // Event code, key or button
+    u8  kind;
+    u8  size;
+};
+
+// Record payloads are at most this many bytes
+constexpr u32 max_payload_size = 0xff;
+
+struct payload_size
+{
+    u16 code;
+    u8  size;
+    u8  warned; // Set once an unsized fire of the code has been dropped
+};
+
+struct recorder_state
+{
+    utl::vector<u8>           data{};
+    utl::vector<payload_size> payload_sizes{};
+    std::string               path{};
+    u64                       read_offset{};
+    u64                       frame{};
+    u64                       frame_count{};
+    f64                       start_time{};
+    f32                       delta{};
+    u32                       suppress{};
+    bool                      recording{};
+    bool                      replaying{};
+    bool                      feeding{};
+    bool                      quit_when_done{};
+};
+
+recorder_state state{};
+
+f64 now()
+{
+    using namespace std::chrono;
+    return duration<f64>(steady_clock::now().time_since_epoch()).count();
+}
+
+payload_size* find_payload_size(u16 code)
+{
+    for (payload_size& entry : state.payload_sizes)
+    {
+        if (entry.code == code)
+            return &entry;
+    }
+    return nullptr;
+}
+
+// fire takes no payload size, so it's either one of the system codes' known sizes or declared with set_payload_size.
+// Returns false if the code has neither
+bool known_payload_size(u16 code, u32& size)
+{
+    switch (code)
+    {
+    case events::system_event::key_pressed:
+    case events::system_event::key_released:
+    case events::system_event::button_pressed:
+    case events::system_event::button_released: size = sizeof(u16); return true;
+    case events::system_event::mouse_moved:
+    case events::system_event::resized: size = sizeof(u32); return true;
+    case events::system_event::mouse_wheel: size = sizeof(i8); return true;
+    default: break;
+    }
+
+    const payload_size* entry{ find_payload_size(code) };
+    if (!entry || !entry->size)
+        return false;
+
+    size = entry->size;
+    return true;
+}
+
+// As known_payload_size, warning the first time a fire can't be recorded
+bool fired_payload_size(u16 code, u32& size)
+{
+    if (known_payload_size(code, size))
+        return true;
+
+    payload_size* entry{ find_payload_size(code) };
+    if (!entry)
+    {
+        entry = &state.payload_sizes.emplace_back();
+        *entry = { code, 0, 0 };
+    }
+
+    if (!entry->warned)
+    {
+        LOG_WARN("Not recording fires of event {} with data, since its payload size is unknown. See set_payload_size",
+                 code);
+        entry->warned = true;
+    }
+    return false;
+}
+
+// utl::vector reserves exactly what resize asks for, so growing it record by record would copy everything every time
+void grow_data(u64 size)
+{
+    if (size > state.data.capacity())
+        state.data.reserve(math::max(size, state.data.capacity() * 2));
+    state.data.resize(size);
+}
+
+void append(record_kind::kind kind, u16 code, const void* payload, u32 size)
+{
+    if (!state.recording || state.suppress)
+        return;
+
+    const record_header header{ (u32) state.frame, (f32) (now() - state.start_time), code, kind, (u8) size };
+    const u64           offset{ state.data.size() };
+    grow_data(offset + sizeof(header) + size);
+    memcpy(state.data.data() + offset, &header, sizeof(header));
+    if (size)
+        memcpy(state.data.data() + offset + sizeof(header), payload, size);
+}
+
+void apply(const record_header& header, const u8* payload)
+{
+    switch (header.kind)
+    {
+    case record_kind::fire:
+    {
+        // Copied out, since listeners may cast the payload to anything and records aren't aligned
+        alignas(8) u8 data[max_payload_size];
+        if (header.size)
+            memcpy(data, payload, header.size);
+        events::fire(header.code, nullptr, header.size ? data : nullptr);
+    }
+    break;
+    case record_kind::post: events::post(header.code, nullptr, payload, header.size); break;
+    case record_kind::key: input::process_key((input::key::code) header.code, payload[0] != 0); break;
+    case record_kind::button: input::process_button((input::button::code) header.code, payload[0] != 0); break;
+    case record_kind::mouse_move:
+    {
+        i16 position[2]{};
+        memcpy(position, payload, sizeof(position));
+        input::process_mouse_move(position[0], position[1]);
+    }
+    break;
+    case record_kind::mouse_wheel: input::process_mouse_wheel((i8) payload[0]); break;
+    default: LOG_WARN("Skipping unknown record kind {}", header.kind); break;
+    }
+}
+
+} // anonymous namespace
+
+bool start_recording(const char* path)
+{
+    if (state.recording || state.replaying)
+    {
+        LOG_ERROR("Can't start recording while already recording or replaying");
+        return false;
+    }
+
+    state.data.clear();
+    const file_header header{ file_magic, file_version, 0 };
+    state.data.resize(sizeof(header));
+    memcpy(state.data.data(), &header, sizeof(header));
+
+    state.path       = path;
+    state.frame      = 0;
+    state.start_time = now();
+    state.recording  = true;
+    LOG_INFO("Recording events and input to {}", path);
+    return true;
+}
+
+bool stop_recording()
+{
+    if (!state.recording)
+        return false;
+
+    state.recording = false;
+
+    const u32 frame_count{ (u32) state.frame + 1 };
+    memcpy(state.data.data() + offsetof(file_header, frame_count), &frame_count, sizeof(frame_count));
+
+    utl::fs::file_handle file{};
+    if (!utl::fs::open(state.path.c_str(), utl::fs::file_modes::write, true, file))
+    {
+        LOG_ERROR("Failed to open {} to save the recording", state.path);
+        return false;
+    }
+
+    u64        written{};
+    const bool ok{ utl::fs::write(file, state.data.size(), state.data.data(), written) };
+    utl::fs::close(file);
+
+    LOG_INFO("Saved {} bytes of recording over {} frames to {}", state.data.size(), state.frame + 1, state.path);
+    state.data.clear();
+    return ok;
+}
+
+bool start_replay(const char* path, f32 fixed_delta, bool quit_when_done)
+{
+    if (state.recording || state.replaying)
+    {
+        LOG_ERROR("Can't start a replay while already recording or replaying");
+        return false;
+    }
+
+    utl::fs::file_handle file{};
+    if (!utl::fs::open(path, utl::fs::file_modes::read, true, file))
+    {
+        LOG_ERROR("Failed to open recording {}", path);
+        return false;
+    }
+
+    state.data.clear();
+    constexpr u64 block_size = 4_KB;
+    for (u64 read_size = block_size; read_size == block_size;)
+    {
+        const u64 offset{ state.data.size() };
+        grow_data(offset + block_size);
+        utl::fs::read(file, block_size, state.data.data() + offset, read_size);
+        state.data.resize(offset + read_size);
+    }
+    utl::fs::close(file);
+
+    file_header header{};
+    if (state.data.size() < sizeof(header))
+        return false;
+    memcpy(&header, state.data.data(), sizeof(header));
+    if (header.magic != file_magic || header.version != file_version)
+    {
+        LOG_ERROR("{} is not a recording this version can play", path);
+        state.data.clear();
+        return false;
+    }
+
+    state.read_offset    = sizeof(header);
+    state.frame_count    = header.frame_count;
+    state.delta          = fixed_delta;
+    state.quit_when_done = quit_when_done;
+    state.replaying      = true;
+    LOG_INFO("Replaying {} ({} bytes) with a fixed delta of {}", path, state.data.size(), fixed_delta);
+    return true;
+}
+
+void stop_replay()
+{
+    state.replaying = false;
+    state.data.clear();
+}
+
+bool is_recording()
+{
+    return state.recording;
+}
+
+bool is_replaying()
+{
+    return state.replaying;
+}
+
+void begin_frame(u64 frame)
+{
+    state.frame = frame;
+    if (!state.replaying)
+        return;
+
+    // Ends at the first frame past the recording, so the live game can't raise events during its last frame
+    if (frame >= state.frame_count)
+    {
+        LOG_INFO("Replay finished at frame {}", frame);
+        stop_replay();
+        if (state.quit_when_done)
+            events::fire(events::system_event::application_quit, nullptr, nullptr);
+        return;
+    }
+
+    state.feeding = true;
+    while (state.read_offset + sizeof(record_header) <= state.data.size())
+    {
+        record_header header{};
+        memcpy(&header, state.data.data() + state.read_offset, sizeof(header));
+        if (header.frame > frame)
+            break;
+
+        if (state.read_offset + sizeof(header) + header.size > state.data.size())
+        {
+            LOG_ERROR("Recording is damaged at offset {}, stopping the replay", state.read_offset);
+            stop_replay();
+            break;
+        }
+
+        apply(header, state.data.data() + state.read_offset + sizeof(header));
+        state.read_offset += sizeof(header) + header.size;
+    }
+    state.feeding = false;
+}
+
+bool fixed_delta(f32& delta)
+{
+    if (!state.replaying)
+        return false;
+
+    delta = state.delta;
+    return true;
+}
+
+bool set_payload_size(u16 code, u32 size)
+{
+    if (size > max_payload_size)
+    {
+        LOG_ERROR("Payload of {} bytes is too large to record (max {})", size, max_payload_size);
+        return false;
+    }
+
+    payload_size* entry{ find_payload_size(code) };
+    if (!entry)
+        entry = &state.payload_sizes.emplace_back();
+    *entry = { code, (u8) size, 0 };
+    return true;
+}
+
+void record_fire(u16 code, const void* data)
+{
+    if (!state.recording || state.suppress)
+        return;
+
+    u32 size{};
+    if (data && !fired_payload_size(code, size))
+        return;
+
+    append(record_kind::fire, code, data, size);
+}
+
+void record_post(u16 code, const void* data, u32 size)
+{
+    append(record_kind::post, code, data, size);
+}
+
+void record_key(u16 key, bool pressed)
+{
+    const u8 down{ pressed };
+    append(record_kind::key, key, &down, sizeof(down));
+}
+
+void record_button(u16 button, bool pressed)
+{
+    const u8 down{ pressed };
+    append(record_kind::button, button, &down, sizeof(down));
+}
+
+void record_mouse_move(i16 x, i16 y)
+{
+    const i16 position[2]{ x, y };
+    append(record_kind::mouse_move, 0, position, sizeof(position));
+}
+
+void record_mouse_wheel(i8 delta)
+{
+    append(record_kind::mouse_wheel, 0, &delta, sizeof(delta));
+}
+
+bool blocks_live_input()
+{
+    return state.replaying && !state.feeding;
+}
+
+bool blocks_live_event(u16 code)
+{
+    return state.replaying && !state.feeding && !state.suppress && code != events::system_event::application_quit;
+}
+
+bool blocks_live_fire(u16 code, const void* data)
+{
+    u32 size{};
+    return blocks_live_event(code) && (!data || known_payload_size(code, size));
+}
+
+scoped_suppress::scoped_suppress()
+{
+    ++state.suppress;
+}
+
+scoped_suppress::~scoped_suppress()
+{
+    --state.suppress;
+}
+
+} // namespace sky::recorder
\ No newline at end of file
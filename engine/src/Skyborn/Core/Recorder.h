@@ -0,0 +1,103 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Recorder.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+
+// Records the events and input of a session to a file and plays it back frame by frame, so the same session can be
+// rerun for performance comparisons
+namespace sky::recorder
+{
+/**
+ * Starts capturing every fired or posted event and every input::process_* call
+ * @param path File the recording is written to when stopped
+ * @return true if recording started, false otherwise
+ */
+SAPI bool start_recording(const char* path);
+
+// Writes the recording to its file
+SAPI bool stop_recording();
+
+/**
+ * Loads a recording and feeds it back, frame by frame, from the next begin_frame on. Live input and events are ignored
+ * meanwhile and app::run steps the game with fixed_delta instead of the measured frame time
+ * @param path The recording to play
+ * @param fixed_delta Seconds per frame handed to the game
+ * @param quit_when_done Fires application_quit after the last recorded frame
+ * @return true if the recording was loaded, false otherwise
+ */
+SAPI bool start_replay(const char* path, f32 fixed_delta = 1.f / 60.f, bool quit_when_done = true);
+SAPI void stop_replay();
+
+[[nodiscard]] SAPI bool is_recording();
+[[nodiscard]] SAPI bool is_replaying();
+
+/**
+ * Marks the start of a frame. While recording, stamps what follows with the frame. While replaying, feeds everything
+ * recorded for the frame back through input::process_* and events::fire/post
+ * @param frame Frame index, counted from the first frame after recording or replay started
+ */
+SAPI void begin_frame(u64 frame);
+
+// The delta to step the game with while replaying. Returns false if not replaying
+SAPI bool fixed_delta(f32& delta);
+
+/**
+ * Declares the size of the data fire passes with a code, so fires of it can be recorded with their payload. The system
+ * codes' sizes are built in. Fires of other codes with data but no declared size aren't recorded, since a replay
+ * would hand their listeners a null pointer
+ * @param code The event code
+ * @param size Payload size in bytes, at most 255
+ * @return true if the size was set, false if it's too large
+ */
+SAPI bool set_payload_size(u16 code, u32 size);
+
+// Called from events and input. Nested calls (e.g. the events an input call fires) aren't recorded again, since
+// replaying the outer call raises them anyway
+SAPI void record_fire(u16 code, const void* data);
+SAPI void record_post(u16 code, const void* data, u32 size);
+SAPI void record_key(u16 key, bool pressed);
+SAPI void record_button(u16 button, bool pressed);
+SAPI void record_mouse_move(i16 x, i16 y);
+SAPI void record_mouse_wheel(i8 delta);
+
+// True while a replay is running, except for the input it feeds itself
+[[nodiscard]] SAPI bool blocks_live_input();
+
+// True for top level fires and posts while a replay is running, other than those it feeds itself. The recording
+// already has them, so letting the live game raise them again would deliver them twice. Quitting is never blocked
+[[nodiscard]] SAPI bool blocks_live_event(u16 code);
+
+// As blocks_live_event, except for fires with a payload of unknown size. Those aren't recorded, so the live game keeps
+// raising them during a replay
+[[nodiscard]] SAPI bool blocks_live_fire(u16 code, const void* data);
+
+// Stops nested calls from being recorded while in scope
+struct scoped_suppress
+{
+    SAPI scoped_suppress();
+    SAPI ~scoped_suppress();
+};
+} // namespace sky::recorder
\ No newline at end of file
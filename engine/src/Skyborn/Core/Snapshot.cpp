@@ -0,0 +1,291 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Snapshot.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Snapshot.h"
+
+#include "Skyborn/Debug/Logger.h"
+#include "Skyborn/ECS/World.h"
+#include "Skyborn/Util/Vector.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace sky::snapshot
+{
+namespace
+{
+
+struct entry
+{
+    const char* name;
+    void*       data;
+    u64         size;
+    ecs::world* world; // If set, data and size are unused
+};
+
+struct frame_slot
+{
+    u8* data;
+    u64 size;
+    u64 capacity;
+    u64 frame;
+};
+
+bool                    is_initialized = false;
+utl::vector<entry>      entries{};
+utl::vector<frame_slot> slots{};
+u32                     next_slot{};
+snapshot_stats          last_stats{};
+
+f64 now_us()
+{
+    using namespace std::chrono;
+    return (f64) duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1000.0;
+}
+
+bool reserve(frame_slot& slot, u64 size)
+{
+    if (size <= slot.capacity)
+        return true;
+
+    void* data{ realloc(slot.data, size) };
+    if (!data)
+    {
+        LOG_ERROR("Failed to grow snapshot frame to {} bytes", size);
+        return false;
+    }
+
+    LOG_WARN("Snapshot frame grew from {} to {} bytes. Consider a larger frame_capacity", slot.capacity, size);
+    slot.data     = (u8*) data;
+    slot.capacity = size;
+    return true;
+}
+
+// Saved snapshots were laid out for the old set of entries, so none of them can be restored anymore
+void invalidate_frames()
+{
+    for (auto& slot : slots)
+        slot.frame = u64_invalid;
+}
+
+u32 add_entry(const entry& e)
+{
+    if (!is_initialized)
+        return u32_invalid;
+
+    invalidate_frames();
+    for (u32 i = 0; i < entries.size(); ++i)
+    {
+        if (!entries[i].name)
+        {
+            entries[i] = e;
+            return i;
+        }
+    }
+
+    entries.push_back(e);
+    return (u32) entries.size() - 1;
+}
+
+} // anonymous namespace
+
+bool initialize(const snapshot_desc& desc)
+{
+    if (is_initialized)
+        return false;
+
+    if (!desc.frame_count)
+    {
+        LOG_ERROR("Snapshots need at least one frame");
+        return false;
+    }
+
+    slots.resize(desc.frame_count);
+    for (auto& slot : slots)
+    {
+        slot = { (u8*) malloc(desc.frame_capacity), 0, desc.frame_capacity, u64_invalid };
+        if (!slot.data)
+        {
+            LOG_ERROR("Failed to allocate {} bytes for a snapshot frame", desc.frame_capacity);
+            return false;
+        }
+    }
+
+    next_slot      = 0;
+    is_initialized = true;
+    LOG_INFO("Snapshot submodule initialized ({} frames of {} bytes)", desc.frame_count, desc.frame_capacity);
+    return true;
+}
+
+void shutdown()
+{
+    for (auto& slot : slots)
+        free(slot.data);
+
+    slots.clear();
+    entries.clear();
+    last_stats     = {};
+    is_initialized = false;
+    LOG_INFO("Snapshot submodule shutdown");
+}
+
+u32 register_state(const char* name, void* data, u64 size)
+{
+    sky_assert(name && data && size);
+    return add_entry({ name, data, size, nullptr });
+}
+
+u32 register_world(const char* name, ecs::world* world)
+{
+    sky_assert(name && world);
+    return add_entry({ name, nullptr, 0, world });
+}
+
+bool unregister(u32 id)
+{
+    if (!is_initialized || id >= entries.size() || !entries[id].name)
+        return false;
+
+    entries[id] = {};
+    invalidate_frames();
+    return true;
+}
+
+bool save(u64 frame)
+{
+    if (!is_initialized)
+        return false;
+
+    const f64 start{ now_us() };
+
+    u64 size = 0;
+    for (const auto& e : entries)
+    {
+        if (e.world)
+            size += sizeof(u64) + e.world->snapshot_size();
+        else
+            size += e.size;
+    }
+
+    frame_slot& slot{ slots[next_slot] };
+    slot.frame = u64_invalid;
+    if (!reserve(slot, size))
+        return false;
+
+    u8* out{ slot.data };
+    for (const auto& e : entries)
+    {
+        if (e.world)
+        {
+            const u64 world_size{ e.world->snapshot_size() };
+            memcpy(out, &world_size, sizeof(u64));
+            e.world->save(out + sizeof(u64));
+            out += sizeof(u64) + world_size;
+        } else if (e.data)
+        {
+            memcpy(out, e.data, e.size);
+            out += e.size;
+        }
+    }
+
+    slot.size  = size;
+    slot.frame = frame;
+    next_slot  = (next_slot + 1) % (u32) slots.size();
+
+    last_stats.size    = size;
+    last_stats.save_us = now_us() - start;
+    return true;
+}
+
+bool restore(u64 frame)
+{
+    if (!is_initialized || frame == u64_invalid)
+        return false;
+
+    const f64 start{ now_us() };
+    for (const auto& slot : slots)
+    {
+        if (slot.frame != frame)
+            continue;
+
+        // Check every world's save first, so a failed restore leaves all of the state as it was
+        const u8* in{ slot.data };
+        for (const auto& e : entries)
+        {
+            if (e.world)
+            {
+                u64 world_size{};
+                memcpy(&world_size, in, sizeof(u64));
+                if (!e.world->can_load(in + sizeof(u64), world_size))
+                {
+                    LOG_ERROR("Failed to restore world '{}' from frame {}", e.name, frame);
+                    return false;
+                }
+                in += sizeof(u64) + world_size;
+            } else if (e.data)
+            {
+                in += e.size;
+            }
+        }
+
+        in = slot.data;
+        for (const auto& e : entries)
+        {
+            if (e.world)
+            {
+                u64 world_size{};
+                memcpy(&world_size, in, sizeof(u64));
+                e.world->load_unchecked(in + sizeof(u64), world_size);
+                in += sizeof(u64) + world_size;
+            } else if (e.data)
+            {
+                memcpy(e.data, in, e.size);
+                in += e.size;
+            }
+        }
+
+        last_stats.restore_us = now_us() - start;
+        return true;
+    }
+
+    LOG_WARN("Snapshot for frame {} is no longer available", frame);
+    return false;
+}
+
+bool has_frame(u64 frame)
+{
+    for (const auto& slot : slots)
+    {
+        if (slot.frame == frame && frame != u64_invalid)
+            return true;
+    }
+    return false;
+}
+
+const snapshot_stats& stats()
+{
+    return last_stats;
+}
+
+} // namespace sky::snapshot
\ No newline at end of file
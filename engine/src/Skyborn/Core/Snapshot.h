@@ -0,0 +1,83 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Snapshot.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+
+namespace sky::ecs
+{
+class world;
+}
+
+namespace sky::snapshot
+{
+struct snapshot_desc
+{
+    u32 frame_count{ 8 };       // Snapshots kept before the oldest is overwritten
+    u64 frame_capacity{ 1_MB }; // Preallocated per frame. Frames only grow if the registered state outgrows this
+};
+
+struct snapshot_stats
+{
+    u64 size{};       // Bytes in the last saved snapshot
+    f64 save_us{};    // Microseconds the last save took
+    f64 restore_us{}; // Microseconds the last restore took
+};
+
+SAPI bool initialize(const snapshot_desc& desc = {});
+SAPI void shutdown();
+
+/**
+ * Registers a block of plain memory, e.g. a game's state struct, to be included in every snapshot
+ * @param name Used for logging
+ * @param data The memory to save and restore. Must stay valid until unregistered
+ * @param size Size of the block in bytes
+ * @return An id for unregister, or u32_invalid on failure
+ */
+SAPI u32 register_state(const char* name, void* data, u64 size);
+
+// Registers an ECS world to be included in every snapshot
+SAPI u32 register_world(const char* name, ecs::world* world);
+
+SAPI bool unregister(u32 id);
+
+/**
+ * Copies all registered state into the ring buffer
+ * @param frame Tag for the snapshot, typically the simulation frame. Overwrites the oldest snapshot when full
+ * @return true if saved, false otherwise
+ */
+SAPI bool save(u64 frame);
+
+/**
+ * Copies a saved snapshot back into the registered state
+ * @param frame The tag given to save
+ * @return true if the frame was still in the ring and was restored, false otherwise
+ */
+SAPI bool restore(u64 frame);
+
+[[nodiscard]] SAPI bool has_frame(u64 frame);
+
+[[nodiscard]] SAPI const snapshot_stats& stats();
+} // namespace sky::snapshot
\ No newline at end of file
@@ -0,0 +1,148 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Thread.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Thread.h"
+
+#include "Skyborn/Debug/Logger.h"
+
+#include <string>
+
+namespace sky::threading
+{
+namespace
+{
+
+// Fallback when the platform can't tell us anything: every logical cpu is its own core
+void flat_topology(cpu_topology& topology)
+{
+    u32 count = std::thread::hardware_concurrency();
+    if (count == 0)
+        count = 1;
+    if (count > max_logical_cpus)
+        count = max_logical_cpus;
+
+    topology = {};
+    for (u32 i = 0; i < count; ++i)
+    {
+        topology.logical.push_back({ i, i, 0, 0, core_kind::unknown });
+        topology.cores.push_back({ 0, core_kind::unknown, cpu_set::single(i) });
+    }
+    topology.packages = 1;
+}
+
+cpu_topology detect()
+{
+    cpu_topology topology{};
+    if (!detect_topology(topology) || topology.logical.empty())
+    {
+        LOG_WARN("CPU topology detection failed. Assuming one thread per core");
+        flat_topology(topology);
+    }
+
+    u32 performance = 0;
+    u32 efficiency  = 0;
+    for (const auto& core : topology.cores)
+    {
+        performance += core.kind == core_kind::performance;
+        efficiency += core.kind == core_kind::efficiency;
+    }
+    topology.hybrid = performance && efficiency;
+
+    LOG_INFO("CPU topology: {} package(s), {} core(s), {} logical processor(s), {} cache group(s)", topology.packages,
+             topology.cores.size(), topology.logical.size(), topology.caches.size());
+    if (topology.hybrid)
+    {
+        LOG_INFO("Hybrid CPU: {} performance core(s), {} efficiency core(s)", performance, efficiency);
+    }
+
+    return topology;
+}
+
+} // anonymous namespace
+
+const cpu_topology& get_cpu_topology()
+{
+    static const cpu_topology topology{ detect() };
+    return topology;
+}
+
+cpu_set all_cpus()
+{
+    cpu_set set{};
+    for (const auto& cpu : get_cpu_topology().logical)
+        set.set(cpu.id);
+    return set;
+}
+
+cpu_set cores_of_kind(core_kind::kind kind, bool primary_threads_only)
+{
+    const cpu_topology& topology = get_cpu_topology();
+
+    cpu_set set{};
+    for (const auto& cpu : topology.logical)
+    {
+        if (primary_threads_only && cpu.smt_index != 0)
+            continue;
+        if (kind != core_kind::unknown && topology.hybrid && cpu.kind != kind)
+            continue;
+        set.set(cpu.id);
+    }
+    return set;
+}
+
+cpu_set last_level_cache_of(u32 cpu)
+{
+    cpu_set best{};
+    u8      best_level = 0;
+    for (const auto& cache : get_cpu_topology().caches)
+    {
+        if (cache.level > best_level && cache.shared_by.test(cpu))
+        {
+            best       = cache.shared_by;
+            best_level = cache.level;
+        }
+    }
+
+    return best_level ? best : cpu_set::single(cpu);
+}
+
+std::thread create_thread(const thread_desc& desc, std::function<void()> func)
+{
+    // The name has to outlive the caller's desc, so copy it into the closure
+    std::string name{ desc.name ? desc.name : "" };
+    cpu_set     affinity{ desc.affinity };
+
+    return std::thread{ [name = std::move(name), affinity, func = std::move(func)] {
+        if (!name.empty())
+        {
+            set_thread_name(name.c_str());
+        }
+        if (!affinity.empty() && !set_thread_affinity(affinity))
+        {
+            LOG_WARN("Failed to set affinity for thread '{}'", name);
+        }
+        func();
+    } };
+}
+
+} // namespace sky::threading
\ No newline at end of file
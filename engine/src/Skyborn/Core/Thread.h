@@ -0,0 +1,188 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Thread.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+#include "Skyborn/Util/Vector.h"
+
+#include <bit>
+#include <functional>
+#include <thread>
+
+namespace sky::threading
+{
+constexpr u32 max_logical_cpus = 256;
+constexpr u32 cpu_set_words    = max_logical_cpus / 64;
+
+struct core_kind
+{
+    enum kind : u8
+    {
+        // Non-hybrid CPU, or the OS doesn't report core classes
+        unknown,
+        performance,
+        efficiency,
+    };
+};
+
+// Bitmask of logical processors. Bit i is logical processor i as numbered by the OS
+struct cpu_set
+{
+    u64 bits[cpu_set_words]{};
+
+    constexpr void set(u32 cpu)
+    {
+        if (cpu < max_logical_cpus)
+            bits[cpu >> 6] |= 1ull << (cpu & 63);
+    }
+
+    constexpr void clear(u32 cpu)
+    {
+        if (cpu < max_logical_cpus)
+            bits[cpu >> 6] &= ~(1ull << (cpu & 63));
+    }
+
+    [[nodiscard]] constexpr bool test(u32 cpu) const
+    {
+        return cpu < max_logical_cpus && (bits[cpu >> 6] & (1ull << (cpu & 63))) != 0;
+    }
+
+    [[nodiscard]] constexpr u32 count() const
+    {
+        u32 total = 0;
+        for (const u64 word : bits)
+            total += (u32) std::popcount(word);
+        return total;
+    }
+
+    [[nodiscard]] constexpr bool empty() const { return count() == 0; }
+
+    // Index of the lowest set cpu, or u32_invalid if empty
+    [[nodiscard]] constexpr u32 first() const
+    {
+        for (u32 i = 0; i < cpu_set_words; ++i)
+        {
+            if (bits[i])
+                return i * 64 + (u32) std::countr_zero(bits[i]);
+        }
+        return u32_invalid;
+    }
+
+    constexpr cpu_set& operator|=(const cpu_set& o)
+    {
+        for (u32 i = 0; i < cpu_set_words; ++i)
+            bits[i] |= o.bits[i];
+        return *this;
+    }
+
+    constexpr cpu_set& operator&=(const cpu_set& o)
+    {
+        for (u32 i = 0; i < cpu_set_words; ++i)
+            bits[i] &= o.bits[i];
+        return *this;
+    }
+
+    constexpr friend cpu_set operator|(cpu_set a, const cpu_set& b) { return a |= b; }
+
+    constexpr friend cpu_set operator&(cpu_set a, const cpu_set& b) { return a &= b; }
+
+    constexpr bool operator==(const cpu_set& o) const = default;
+
+    static constexpr cpu_set single(u32 cpu)
+    {
+        cpu_set s{};
+        s.set(cpu);
+        return s;
+    }
+};
+
+struct logical_cpu
+{
+    u32             id{};        // OS logical processor index
+    u32             core{};      // Index into cpu_topology::cores
+    u32             package{};   // Physical socket
+    u32             smt_index{}; // 0 for the first hardware thread of a core, 1 for its SMT sibling, etc.
+    core_kind::kind kind{};
+};
+
+struct physical_core
+{
+    u32             package{};
+    core_kind::kind kind{};
+    cpu_set         threads{}; // SMT siblings sharing this core
+};
+
+struct cache_group
+{
+    u8      level{};
+    u64     size{}; // In bytes
+    cpu_set shared_by{};
+};
+
+struct cpu_topology
+{
+    utl::vector<logical_cpu>   logical{};
+    utl::vector<physical_core> cores{};
+    utl::vector<cache_group>   caches{}; // Data and unified caches, one entry per sharing group
+    u32                        packages{};
+    bool                       hybrid{};
+};
+
+struct thread_desc
+{
+    const char* name{};     // Shows up in debuggers and profilers. Linux truncates to 15 characters
+    cpu_set     affinity{}; // Empty lets the OS place the thread
+};
+
+// Detected once on first use and cached for the rest of the run
+SAPI const cpu_topology& get_cpu_topology();
+
+SAPI cpu_set all_cpus();
+
+// Every logical cpu on cores of the given kind. core_kind::unknown matches all cores.
+// With primary_threads_only set, only the first hardware thread of each core is included
+SAPI cpu_set cores_of_kind(core_kind::kind kind, bool primary_threads_only);
+
+// Logical cpus sharing the last level cache with the given cpu
+SAPI cpu_set last_level_cache_of(u32 cpu);
+
+/**
+ * Creates a thread which names and pins itself before running the given function
+ * @param desc Name and affinity for the new thread
+ * @param func The thread body
+ * @return The running thread. The caller owns it and must join or detach it
+ */
+SAPI std::thread create_thread(const thread_desc& desc, std::function<void()> func);
+
+// The following act on the calling thread
+
+SAPI bool set_thread_affinity(const cpu_set& cpus);
+SAPI bool set_thread_name(const char* name);
+SAPI u32  current_cpu();
+
+// Implemented per platform
+bool detect_topology(cpu_topology& topology);
+
+} // namespace sky::threading
\ No newline at end of file
@@ -0,0 +1,311 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: ThreadLinux.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Thread.h"
+
+#if !defined(__linux__)
+    #error This file should only be compiled on Linux
+#endif
+
+#include "Skyborn/Debug/Logger.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace sky::threading
+{
+namespace
+{
+
+constexpr u32 max_cache_indices = 8;
+
+bool read_file(const char* path, char* buffer, u32 size)
+{
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    u64 length = fread(buffer, 1, size - 1, file);
+    fclose(file);
+
+    // sysfs values end with a new line
+    while (length && (buffer[length - 1] == '\n' || buffer[length - 1] == ' '))
+        --length;
+    buffer[length] = '\0';
+
+    return length > 0;
+}
+
+bool read_u32(const char* path, u32& value)
+{
+    char buffer[32];
+    if (!read_file(path, buffer, sizeof(buffer)))
+        return false;
+
+    value = (u32) strtoul(buffer, nullptr, 10);
+    return true;
+}
+
+// Parses lists like "0-3,8,10-11"
+bool parse_cpu_list(const char* list, cpu_set& set)
+{
+    const char* it = list;
+    while (*it)
+    {
+        char*     end   = nullptr;
+        const u32 first = (u32) strtoul(it, &end, 10);
+        if (end == it)
+            return false;
+
+        u32 last = first;
+        it       = end;
+        if (*it == '-')
+        {
+            last = (u32) strtoul(it + 1, &end, 10);
+            it   = end;
+        }
+
+        for (u32 cpu = first; cpu <= last && cpu < max_logical_cpus; ++cpu)
+            set.set(cpu);
+
+        if (*it == ',')
+            ++it;
+        else
+            break;
+    }
+
+    return true;
+}
+
+bool read_cpu_list(const char* path, cpu_set& set)
+{
+    char buffer[1024];
+    return read_file(path, buffer, sizeof(buffer)) && parse_cpu_list(buffer, set);
+}
+
+// Cache sizes are reported like "48K" or "2048K"
+u64 parse_size(const char* text)
+{
+    char* end  = nullptr;
+    u64   size = strtoull(text, &end, 10);
+    switch (*end)
+    {
+    case 'K': size *= 1_KB; break;
+    case 'M': size *= 1_MB; break;
+    case 'G': size *= 1_GB; break;
+    default: break;
+    }
+    return size;
+}
+
+void detect_core_kinds(cpu_topology& topology)
+{
+    // Intel hybrid parts expose one PMU per core type
+    cpu_set performance{};
+    cpu_set efficiency{};
+    if (read_cpu_list("/sys/devices/cpu_core/cpus", performance) &&
+        read_cpu_list("/sys/devices/cpu_atom/cpus", efficiency))
+    {
+        for (auto& cpu : topology.logical)
+        {
+            if (performance.test(cpu.id))
+                cpu.kind = core_kind::performance;
+            else if (efficiency.test(cpu.id))
+                cpu.kind = core_kind::efficiency;
+        }
+    } else
+    {
+        // ARM big.LITTLE reports a relative capacity per cpu instead
+        utl::vector<u32> capacities{};
+        u32              max_capacity = 0;
+        u32              min_capacity = u32_max;
+        char             path[128];
+        for (const auto& cpu : topology.logical)
+        {
+            u32 capacity = 0;
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpu_capacity", cpu.id);
+            if (!read_u32(path, capacity))
+                return;
+
+            capacities.push_back(capacity);
+            max_capacity = capacity > max_capacity ? capacity : max_capacity;
+            min_capacity = capacity < min_capacity ? capacity : min_capacity;
+        }
+
+        if (max_capacity == min_capacity)
+            return;
+
+        for (u64 i = 0; i < topology.logical.size(); ++i)
+        {
+            topology.logical[i].kind =
+                capacities[i] == max_capacity ? core_kind::performance : core_kind::efficiency;
+        }
+    }
+
+    for (const auto& cpu : topology.logical)
+        topology.cores[cpu.core].kind = cpu.kind;
+}
+
+void detect_caches(cpu_topology& topology)
+{
+    char path[128];
+    char buffer[64];
+    for (const auto& cpu : topology.logical)
+    {
+        for (u32 index = 0; index < max_cache_indices; ++index)
+        {
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/type", cpu.id, index);
+            if (!read_file(path, buffer, sizeof(buffer)))
+                break;
+            if (strcmp(buffer, "Instruction") == 0)
+                continue;
+
+            cache_group cache{};
+            u32         level = 0;
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu.id, index);
+            if (!read_u32(path, level))
+                continue;
+            cache.level = (u8) level;
+
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/size", cpu.id, index);
+            if (read_file(path, buffer, sizeof(buffer)))
+                cache.size = parse_size(buffer);
+
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu.id,
+                     index);
+            if (!read_cpu_list(path, cache.shared_by))
+                cache.shared_by = cpu_set::single(cpu.id);
+
+            bool known = false;
+            for (const auto& existing : topology.caches)
+            {
+                if (existing.level == cache.level && existing.shared_by == cache.shared_by)
+                {
+                    known = true;
+                    break;
+                }
+            }
+
+            if (!known)
+                topology.caches.push_back(cache);
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool detect_topology(cpu_topology& topology)
+{
+    cpu_set online{};
+    if (!read_cpu_list("/sys/devices/system/cpu/online", online))
+        return false;
+
+    // (package, core_id) pairs in the order they were discovered, parallel to topology.cores
+    struct core_key
+    {
+        u32 package;
+        u32 core_id;
+    };
+    utl::vector<core_key> keys{};
+    utl::vector<u32>      packages{};
+    char                  path[128];
+
+    for (u32 id = 0; id < max_logical_cpus; ++id)
+    {
+        if (!online.test(id))
+            continue;
+
+        u32 package = 0;
+        u32 core_id = id;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", id);
+        read_u32(path, package);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", id);
+        read_u32(path, core_id);
+
+        u32 core = u32_invalid;
+        for (u32 i = 0; i < keys.size(); ++i)
+        {
+            if (keys[i].package == package && keys[i].core_id == core_id)
+            {
+                core = i;
+                break;
+            }
+        }
+
+        if (core == u32_invalid)
+        {
+            core = (u32) keys.size();
+            keys.push_back({ package, core_id });
+            topology.cores.push_back({ package, core_kind::unknown, {} });
+        }
+
+        bool known_package = false;
+        for (const u32 p : packages)
+            known_package |= p == package;
+        if (!known_package)
+            packages.push_back(package);
+
+        physical_core& owner = topology.cores[core];
+        topology.logical.push_back({ id, core, package, owner.threads.count(), core_kind::unknown });
+        owner.threads.set(id);
+    }
+
+    topology.packages = (u32) packages.size();
+
+    detect_core_kinds(topology);
+    detect_caches(topology);
+    return !topology.logical.empty();
+}
+
+bool set_thread_affinity(const cpu_set& cpus)
+{
+    cpu_set_t native;
+    CPU_ZERO(&native);
+    for (u32 cpu = 0; cpu < max_logical_cpus && cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (cpus.test(cpu))
+            CPU_SET(cpu, &native);
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(native), &native) == 0;
+}
+
+bool set_thread_name(const char* name)
+{
+    // The kernel limits names to 16 bytes including the terminator
+    char truncated[16];
+    strncpy(truncated, name, sizeof(truncated) - 1);
+    truncated[sizeof(truncated) - 1] = '\0';
+    return pthread_setname_np(pthread_self(), truncated) == 0;
+}
+
+u32 current_cpu()
+{
+    const i32 cpu = sched_getcpu();
+    return cpu < 0 ? u32_invalid : (u32) cpu;
+}
+
+} // namespace sky::threading
\ No newline at end of file
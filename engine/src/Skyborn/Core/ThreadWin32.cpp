@@ -0,0 +1,187 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: ThreadWin32.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Thread.h"
+
+#ifndef SKY_PLATFORM_WINDOWS
+    #error This file should only be compiled on Windows
+#endif
+
+#include "Skyborn/Debug/Logger.h"
+
+#include <Windows.h>
+
+namespace sky::threading
+{
+namespace
+{
+
+// Windows numbers logical processors per group of up to 64
+constexpr u32 logical_index(u16 group, u32 bit)
+{
+    return (u32) group * 64 + bit;
+}
+
+cpu_set to_cpu_set(const GROUP_AFFINITY& affinity)
+{
+    cpu_set set{};
+    for (u32 bit = 0; bit < 64; ++bit)
+    {
+        if (affinity.Mask & (1ull << bit))
+            set.set(logical_index(affinity.Group, bit));
+    }
+    return set;
+}
+
+} // anonymous namespace
+
+bool detect_topology(cpu_topology& topology)
+{
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+        return false;
+
+    utl::vector<u8> buffer(length);
+    auto* info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*) buffer.data();
+    if (!GetLogicalProcessorInformationEx(RelationAll, info, &length))
+        return false;
+
+    // EfficiencyClass is relative: the highest class present is the performance class
+    utl::vector<BYTE> efficiency_classes{};
+    BYTE              max_class = 0;
+    BYTE              min_class = 0xff;
+
+    utl::vector<cpu_set> package_sets{};
+
+    for (DWORD offset = 0; offset < length;)
+    {
+        const auto* entry = (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*) (buffer.data() + offset);
+        switch (entry->Relationship)
+        {
+        case RelationProcessorCore:
+        {
+            const PROCESSOR_RELATIONSHIP& proc = entry->Processor;
+
+            physical_core core{};
+            for (WORD g = 0; g < proc.GroupCount; ++g)
+                core.threads |= to_cpu_set(proc.GroupMask[g]);
+
+            efficiency_classes.push_back(proc.EfficiencyClass);
+            max_class = proc.EfficiencyClass > max_class ? proc.EfficiencyClass : max_class;
+            min_class = proc.EfficiencyClass < min_class ? proc.EfficiencyClass : min_class;
+
+            const u32 core_index = (u32) topology.cores.size();
+            u32       smt_index  = 0;
+            for (u32 cpu = 0; cpu < max_logical_cpus; ++cpu)
+            {
+                if (core.threads.test(cpu))
+                    topology.logical.push_back({ cpu, core_index, 0, smt_index++, core_kind::unknown });
+            }
+            topology.cores.push_back(core);
+        }
+        break;
+        case RelationProcessorPackage:
+        {
+            const PROCESSOR_RELATIONSHIP& proc = entry->Processor;
+
+            cpu_set package{};
+            for (WORD g = 0; g < proc.GroupCount; ++g)
+                package |= to_cpu_set(proc.GroupMask[g]);
+            package_sets.push_back(package);
+        }
+        break;
+        case RelationCache:
+        {
+            const CACHE_RELATIONSHIP& cache = entry->Cache;
+            if (cache.Type != CacheUnified && cache.Type != CacheData)
+                break;
+
+            topology.caches.push_back({ cache.Level, cache.CacheSize, to_cpu_set(cache.GroupMask) });
+        }
+        break;
+        default: break;
+        }
+
+        offset += entry->Size;
+    }
+
+    topology.packages = (u32) package_sets.size();
+
+    for (u32 i = 0; i < topology.cores.size(); ++i)
+    {
+        physical_core& core = topology.cores[i];
+        if (max_class != min_class)
+        {
+            core.kind = efficiency_classes[i] == max_class ? core_kind::performance : core_kind::efficiency;
+        }
+
+        for (u32 p = 0; p < package_sets.size(); ++p)
+        {
+            if ((package_sets[p] & core.threads) == core.threads)
+            {
+                core.package = p;
+                break;
+            }
+        }
+    }
+
+    for (auto& cpu : topology.logical)
+    {
+        cpu.kind    = topology.cores[cpu.core].kind;
+        cpu.package = topology.cores[cpu.core].package;
+    }
+
+    return !topology.logical.empty();
+}
+
+bool set_thread_affinity(const cpu_set& cpus)
+{
+    // A thread can only run within a single processor group, so pin to the group holding the first cpu
+    const u32 first = cpus.first();
+    if (first == u32_invalid)
+        return false;
+
+    GROUP_AFFINITY affinity{};
+    affinity.Group = (WORD) (first / 64);
+    affinity.Mask  = (KAFFINITY) cpus.bits[affinity.Group];
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+}
+
+bool set_thread_name(const char* name)
+{
+    wchar_t wide[64];
+    if (!MultiByteToWideChar(CP_UTF8, 0, name, -1, wide, (i32) _countof(wide)))
+        return false;
+
+    return SUCCEEDED(SetThreadDescription(GetCurrentThread(), wide));
+}
+
+u32 current_cpu()
+{
+    PROCESSOR_NUMBER number{};
+    GetCurrentProcessorNumberEx(&number);
+    return logical_index(number.Group, number.Number);
+}
+
+} // namespace sky::threading
\ No newline at end of file
@@ -0,0 +1,318 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Timer.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Timer.h"
+
+#include "Event.h"
+#include "Recorder.h"
+#include "Skyborn/Debug/Logger.h"
+#include "Skyborn/Util/Maths.h"
+#include "Skyborn/Util/Vector.h"
+
+#include <cmath>
+
+namespace sky::timers
+{
+namespace
+{
+constexpr u32 slot_bits   = 8;
+constexpr u32 slot_count  = 1u << slot_bits;
+constexpr u32 slot_mask   = slot_count - 1;
+constexpr u32 level_count = 4;
+
+// Everything further out than the wheel covers waits in its last slot and is re-slotted when it cascades
+constexpr u64 max_delta = (1ull << (slot_bits * level_count)) - 1;
+
+struct timer_node
+{
+    u64           due;      // Tick it expires on
+    u64           interval; // Ticks between repeats, 0 for one shot
+    func_on_timer on_timer;
+    void*         user_data;
+    u32           generation;
+    u32           prev;
+    u32           next;
+    u32           slot; // Index into heads, u32_invalid when not in a slot
+    u16           code; // Posted instead of calling on_timer, unless u16_invalid
+    bool          active;
+};
+
+struct timers_state
+{
+    utl::vector<timer_node> nodes{};
+    utl::vector<u32>        free_nodes{};
+    u32                     heads[level_count * slot_count]{};
+    u64                     now{}; // Current tick
+    f64                     tick{};
+    f64                     remainder{}; // Seconds advanced that haven't made up a whole tick yet
+    u32                     pending{};
+    bool                    initialized{};
+};
+
+timers_state state{};
+
+u32 slot_for(u64 due)
+{
+    const u64 delta{ math::min(due - state.now, max_delta) };
+    u32       level = 0;
+    while (delta >> (slot_bits * (level + 1)))
+        ++level;
+
+    const u64 at{ delta == max_delta ? state.now + max_delta : due };
+    return level * slot_count + (u32) ((at >> (slot_bits * level)) & slot_mask);
+}
+
+void link(u32 index)
+{
+    timer_node& node{ state.nodes[index] };
+    node.slot = slot_for(node.due);
+    node.prev = u32_invalid;
+    node.next = state.heads[node.slot];
+    if (node.next != u32_invalid)
+        state.nodes[node.next].prev = index;
+    state.heads[node.slot] = index;
+}
+
+void unlink(u32 index)
+{
+    timer_node& node{ state.nodes[index] };
+    if (node.prev != u32_invalid)
+        state.nodes[node.prev].next = node.next;
+    else
+        state.heads[node.slot] = node.next;
+
+    if (node.next != u32_invalid)
+        state.nodes[node.next].prev = node.prev;
+
+    node.slot = u32_invalid;
+}
+
+void release(u32 index)
+{
+    timer_node& node{ state.nodes[index] };
+    node.active = false;
+    ++node.generation;
+    state.free_nodes.push_back(index);
+    --state.pending;
+}
+
+u64 to_ticks(f64 seconds)
+{
+    return (u64) math::max(std::ceil(seconds / state.tick), 0.0);
+}
+
+timer_id add(f64 delay, func_on_timer on_timer, void* user_data, u16 code, f64 interval)
+{
+    if (!state.initialized)
+    {
+        LOG_ERROR("Timers must be initialized before scheduling");
+        return invalid_timer;
+    }
+
+    u32 index;
+    if (!state.free_nodes.empty())
+    {
+        index = state.free_nodes.back();
+        state.free_nodes.erase_unordered(state.free_nodes.size() - 1);
+    } else
+    {
+        index = (u32) state.nodes.size();
+        state.nodes.push_back({});
+    }
+
+    timer_node& node{ state.nodes[index] };
+    // Never the current tick, whose slot is already behind us
+    node.due       = state.now + math::max(to_ticks(delay), (u64) 1);
+    node.interval  = interval > 0.0 ? math::max(to_ticks(interval), (u64) 1) : 0;
+    node.on_timer  = on_timer;
+    node.user_data = user_data;
+    node.code      = code;
+    node.active    = true;
+    link(index);
+    ++state.pending;
+    return { index, node.generation };
+}
+
+bool is_live(timer_id id)
+{
+    return state.initialized && id.index < state.nodes.size() && state.nodes[id.index].active &&
+           state.nodes[id.index].generation == id.generation;
+}
+
+// Moves a higher level slot's timers down now that they are close enough. Returns the slot's index within its level
+u32 cascade(u32 level)
+{
+    const u32 index{ (u32) ((state.now >> (slot_bits * level)) & slot_mask) };
+    u32&      head{ state.heads[level * slot_count + index] };
+    while (head != u32_invalid)
+    {
+        const u32 node{ head };
+        unlink(node);
+        link(node);
+    }
+    return index;
+}
+
+void expire(u32 index, u64 last_tick)
+{
+    timer_node&    node{ state.nodes[index] };
+    const timer_id id{ index, node.generation };
+
+    u32 expirations = 1;
+    if (node.interval)
+    {
+        // Fire once for every period that ends before this advance does, then go again after it
+        expirations += (u32) ((last_tick - node.due) / node.interval);
+        node.due += (u64) expirations * node.interval;
+    }
+
+    // The wheel runs again in a replay, so what it raises mustn't be recorded. It's also not blocked as live, since
+    // the replay doesn't have it
+    recorder::scoped_suppress suppress{};
+    if (node.code != u16_invalid)
+    {
+        const timer_event payload{ id, expirations };
+        events::post(node.code, nullptr, &payload, sizeof(payload));
+    } else
+    {
+        node.on_timer(id, expirations, node.user_data);
+    }
+
+    // The callback may have cancelled it, and the vector may have grown, so look it up again
+    if (!is_live(id))
+        return;
+
+    if (state.nodes[index].interval)
+        link(index);
+    else
+        release(index);
+}
+
+} // anonymous namespace
+
+bool initialize(const timers_desc& desc)
+{
+    if (state.initialized)
+        return false;
+
+    if (desc.tick <= 0.0)
+    {
+        LOG_ERROR("Timer tick must be positive");
+        return false;
+    }
+
+    for (u32& head : state.heads)
+        head = u32_invalid;
+
+    state.tick        = desc.tick;
+    state.now         = 0;
+    state.remainder   = 0.0;
+    state.pending     = 0;
+    state.initialized = true;
+    LOG_INFO("Timer submodule initialized ({} ms ticks)", desc.tick * 1000.0);
+    return true;
+}
+
+void shutdown()
+{
+    state.nodes.clear();
+    state.free_nodes.clear();
+    state.initialized = false;
+    LOG_INFO("Timer submodule shutdown");
+}
+
+timer_id schedule(f64 delay, func_on_timer on_timer, void* user_data, f64 interval)
+{
+    sky_assert(on_timer);
+    return add(delay, on_timer, user_data, u16_invalid, interval);
+}
+
+timer_id schedule_event(f64 delay, u16 code, f64 interval)
+{
+    sky_assert(code != u16_invalid);
+    return add(delay, nullptr, nullptr, code, interval);
+}
+
+bool cancel(timer_id id)
+{
+    if (!is_live(id))
+        return false;
+
+    // Not in a slot while its own callback runs
+    if (state.nodes[id.index].slot != u32_invalid)
+        unlink(id.index);
+    release(id.index);
+    return true;
+}
+
+bool is_pending(timer_id id)
+{
+    return is_live(id);
+}
+
+u32 pending_count()
+{
+    return state.pending;
+}
+
+void advance(f64 seconds)
+{
+    if (!state.initialized || seconds <= 0.0)
+        return;
+
+    state.remainder += seconds;
+    const u64 ticks{ (u64) (state.remainder / state.tick) };
+    state.remainder -= (f64) ticks * state.tick;
+
+    const u64 last_tick{ state.now + ticks };
+    while (state.now < last_tick)
+    {
+        if (!state.pending)
+        {
+            // Nothing to cascade or fire, so there's no need to visit the slots in between
+            state.now = last_tick;
+            break;
+        }
+
+        ++state.now;
+
+        // Finishing a lap of level 0 brings the next slot of level 1 down, and so on up while those wrap too
+        if ((state.now & slot_mask) == 0)
+        {
+            for (u32 level = 1; level < level_count && cascade(level) == 0; ++level)
+            {
+            }
+        }
+
+        // Timers scheduled by callbacks never land in the slot being fired, so it drains
+        u32& head{ state.heads[state.now & slot_mask] };
+        while (head != u32_invalid)
+        {
+            const u32 index{ head };
+            unlink(index);
+            expire(index, last_tick);
+        }
+    }
+}
+
+} // namespace sky::timers
\ No newline at end of file
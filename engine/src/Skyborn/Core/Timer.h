@@ -0,0 +1,97 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Timer.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+
+// Delayed and repeating callbacks on a hierarchical timer wheel, advanced by app::run with each frame's delta.
+// Scheduling and cancelling are O(1), and pending timers cost nothing until their slot comes up
+namespace sky::timers
+{
+// Stable handle. The generation changes whenever the slot is recycled, so stale handles are detected
+struct timer_id
+{
+    u32 index{ u32_invalid };
+    u32 generation{};
+
+    [[nodiscard]] constexpr bool is_valid() const { return index != u32_invalid; }
+
+    constexpr bool operator==(const timer_id& o) const = default;
+};
+
+constexpr timer_id invalid_timer{};
+
+/**
+ * Called when a timer expires
+ * @param id The timer. Still valid inside the callback for repeating timers, so it can cancel itself
+ * @param expirations How many times it expired since it last fired. More than 1 when a repeating timer's interval
+ * is shorter than the frame, since it fires at most once per advance
+ * @param user_data Pointer given when scheduling
+ */
+using func_on_timer = void (*)(timer_id id, u32 expirations, void* user_data);
+
+// Payload of the events posted by schedule_event
+struct timer_event
+{
+    timer_id id;
+    u32      expirations;
+};
+
+struct timers_desc
+{
+    f64 tick{ 0.001 }; // Seconds per tick. Delays are rounded up to whole ticks
+};
+
+SAPI bool initialize(const timers_desc& desc = {});
+SAPI void shutdown();
+
+/**
+ * Calls a function after a delay
+ * @param delay Seconds from now
+ * @param on_timer The callback
+ * @param user_data Handed to the callback
+ * @param interval Seconds between repeats, or 0 to fire once
+ * @return The timer's id, or invalid_timer on failure
+ */
+SAPI timer_id schedule(f64 delay, func_on_timer on_timer, void* user_data = nullptr, f64 interval = 0.0);
+
+/**
+ * Posts an event after a delay, to be fired with the rest of the queued events
+ * @param delay Seconds from now
+ * @param code Event code to post. The payload is a timer_event
+ * @param interval Seconds between repeats, or 0 to fire once
+ * @return The timer's id, or invalid_timer on failure
+ */
+SAPI timer_id schedule_event(f64 delay, u16 code, f64 interval = 0.0);
+
+// Stops a pending or repeating timer. Returns false if it already fired or was cancelled
+SAPI bool cancel(timer_id id);
+
+[[nodiscard]] SAPI bool is_pending(timer_id id);
+[[nodiscard]] SAPI u32 pending_count();
+
+// Moves time forward, firing everything that expires on the way in order of expiry
+SAPI void advance(f64 seconds);
+} // namespace sky::timers
\ No newline at end of file
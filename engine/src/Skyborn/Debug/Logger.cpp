@@ -24,40 +24,1057 @@
 #include "Logger.h"
 
 #include "Skyborn/Core/Platform.h"
+#include "Skyborn/Core/Thread.h"
+#include "Skyborn/Util/FileSystem.h"
 #include "Asserts.h"
 
-#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <ctime>
-#include <sstream>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace sky::logger
 {
-void _send_message(log_level::level lvl, const char* msg)
+namespace
+{
+constexpr u32 binary_magic   = 0x4c594b53; // "SKYL"
+constexpr u32 binary_version = 1;
+constexpr u32 max_formats    = 4096; // Power of two
+constexpr u32 max_args       = 32;
+
+// Binary log files are a header followed by these chunks, packed back to back:
+// format: tag, u32 id, u16 length, format string
+// binary: tag, u8 level, i64 time, u32 format id, u16 size, raw arguments
+// text:   tag, u8 level, i64 time, u16 length, message
+struct chunk
+{
+    enum tag : u8
+    {
+        format = 'F',
+        binary = 'B',
+        text   = 'T',
+    };
+};
+
+// Bounded multi-producer, single-consumer ring, the same scheme as events::post_from_thread. Each cell's sequence
+// says whether it's free for the producer claiming that position or ready for the sink
+struct log_cell
+{
+    std::atomic<u64> sequence;
+    std::time_t      time;
+    log_level::level level;
+    bool             binary;
+    u16              length;
+    u32              format;
+    u8               data[max_async_message]; // The null terminated message, or the raw arguments of a binary one
+};
+
+struct async_state
+{
+    log_cell*               cells{};
+    u32                     mask{};
+    overflow_policy::policy policy{};
+    bool                    binary{};
+    std::thread             sink{};
+    std::mutex              mutex{};
+    std::condition_variable wake{};
+    bool                    quit{};
+
+    // Sink thread only
+    utl::fs::file_handle file{};
+    bool                 has_file{};
+    bool                 formats_written[max_formats]{};
+    std::string          staged{}; // Chunks waiting to be written to the file in one go
+};
+
+async_state                  async{};
+std::atomic<bool>            async_running{};
+std::atomic<u32>             async_users{}; // Threads between checking async_running and finishing with the ring
+alignas(64) std::atomic<u64> head{};    // Next position producers claim
+alignas(64) std::atomic<u64> written{}; // Messages the sink has finished writing
+std::atomic<u64>             dropped{};
+std::atomic<u64>             unreported{}; // Dropped under overflow_policy::count and not yet logged
+
+// Format strings by id. The id is the slot the string's address hashed to
+std::atomic<const char*> format_keys[max_formats]{};
+
+constexpr std::string_view level_prefixes[]{ "][ TRACE ]: ", "][ DEBUG ]: ", "][ INFO ]: ",
+                                             "][ WARNING ]: ", "][ ERROR ]: ", "][ FATAL ]: " };
+
+// One mapped file of the file sink. Retired ones are kept until the sink stops, since a writer may still hold one
+// after it's been swapped out, only to find it's no longer current
+struct log_segment
+{
+    platform::mapped_file file{};
+    std::time_t           rotate_at{}; // 0 for never
+    std::atomic<u64>      reserved{};  // Bytes claimed by writers, which can run past the end
+    std::atomic<u64>      end{};       // Start of the first line that didn't fit
+    std::atomic<u32>      writers{};   // Writers that may still be copying into it
+};
+
+struct file_sink_state
+{
+    std::mutex                mutex{}; // Held while rotating
+    std::filesystem::path     stem{};
+    std::filesystem::path     extension{};
+    u64                       max_size{};
+    u32                       max_age{};
+    u32                       max_files{};
+    u32                       index{}; // Number of the current file
+    utl::vector<log_segment*> retired{};
+};
+
+file_sink_state           file_sink{};
+std::atomic<log_segment*> segment{};
+std::atomic<u8>           console_level{ log_level::trace };
+
+// Set on a thread while it rotates, so whatever it logs meanwhile skips the file instead of waiting on itself
+thread_local bool rotating{};
+
+// The last message from a thread, for deduplication
+struct repeat_state
+{
+    u64              hash{};
+    u32              repeats{}; // Not yet reported
+    std::time_t      since{};   // When the repeats were last reported
+    log_level::level level{};
+
+    // Repeats that are the last thing a thread logs are reported when it exits
+    ~repeat_state();
+};
+
+thread_local repeat_state last_message{};
+std::atomic<bool>         deduplicate{ true };
+
+constexpr std::string_view level_names[]{ "trace", "debug", "info", "warn", "error", "fatal" };
+constexpr const char* category_names[]{ "general", "platform", "input", "renderer", "vulkan", "validation", "frame" };
+static_assert(std::size(category_names) == log_category::count);
+
+#ifdef _DEBUG
+constexpr u8 default_level = log_level::trace;
+#else
+constexpr u8 default_level = log_level::info;
+#endif
+
+bool parse_level(std::string_view name, log_level::level& lvl)
 {
-    bool               is_error = lvl > log_level::warn;
-    std::string        str;
-    auto               t  = std::time(nullptr);
-    auto               tm = *std::localtime(&t);
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%H:%M:%S");
-    std::string time_str = oss.str();
-    switch (lvl)
+    for (u32 i = 0; i < std::size(level_names); ++i)
     {
-    case log_level::trace: str = std::format("[{}][ TRACE ]: {}\n", time_str, msg); break;
-    case log_level::debug: str = std::format("[{}][ DEBUG ]: {}\n", time_str, msg); break;
-    case log_level::info: str = std::format("[{}][ INFO ]: {}\n", time_str, msg); break;
-    case log_level::warn: str = std::format("[{}][ WARNING ]: {}\n", time_str, msg); break;
-    case log_level::error: str = std::format("[{}][ ERROR ]: {}\n", time_str, msg); break;
-    case log_level::fatal: str = std::format("[{}][ FATAL ]: {}\n", time_str, msg); break;
+        if (level_names[i] == name)
+        {
+            lvl = (log_level::level) i;
+            return true;
+        }
     }
+    return false;
+}
+
+struct decoded_arg
+{
+    detail::arg_type::type type;
+    u64                    bits; // Every fixed size argument, bit for bit
+    std::string_view       str;
+};
 
+// Decorates a message as "[HH:MM:SS][ LEVEL ]: message\n" into out, truncating the message to fit
+u64 format_line(char* out, u64 capacity, log_level::level lvl, std::time_t t, const char* msg)
+{
+    // The time only changes once a second, so it's only worth formatting then
+    thread_local std::time_t cached_second{ -1 };
+    thread_local char        cached_time[9]{};
+    if (t != cached_second)
+    {
+        std::tm tm{};
+#ifdef SKY_PLATFORM_WINDOWS
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        std::strftime(cached_time, sizeof(cached_time), "%H:%M:%S", &tm);
+        cached_second = t;
+    }
+
+    const std::string_view prefix{ level_prefixes[lvl] };
+    const u64              message_length{ std::min<u64>(strlen(msg), capacity - prefix.size() - 11) };
+
+    u64 length = 0;
+    out[length++] = '[';
+    memcpy(out + length, cached_time, 8);
+    length += 8;
+    memcpy(out + length, prefix.data(), prefix.size());
+    length += prefix.size();
+    memcpy(out + length, msg, message_length);
+    length += message_length;
+    out[length++] = '\n';
+    out[length]   = 0;
+    return length;
+}
+
+std::filesystem::path segment_path(u32 index)
+{
+    std::filesystem::path path{ file_sink.stem };
+    path += "." + std::to_string(index);
+    path += file_sink.extension;
+    return path;
+}
+
+log_segment* open_segment(std::time_t now)
+{
+    const std::filesystem::path path{ segment_path(file_sink.index) };
+    auto*                       next{ new log_segment{} };
+    if (!platform::map_file(path.string().c_str(), file_sink.max_size, true, next->file))
+    {
+        delete next;
+        return nullptr;
+    }
+
+    next->end.store(u64_invalid, std::memory_order_relaxed);
+    next->rotate_at = file_sink.max_age ? now + file_sink.max_age : 0;
+
+    if (file_sink.index >= file_sink.max_files)
+    {
+        std::error_code error;
+        std::filesystem::remove(segment_path(file_sink.index - file_sink.max_files), error);
+    }
+    return next;
+}
+
+// Waits out the writers still copying into a segment that's been swapped out, then trims and unmaps it
+void retire(log_segment* old)
+{
+    while (old->writers.load() != 0)
+        std::this_thread::yield();
+
+    const u64 used{ std::min(old->end.load(std::memory_order_relaxed), old->reserved.load(std::memory_order_relaxed)) };
+    platform::unmap_file(old->file, used);
+    file_sink.retired.push_back(old);
+}
+
+void rotate(log_segment* full, std::time_t now)
+{
+    std::lock_guard lock{ file_sink.mutex };
+    if (segment.load() != full)
+        return; // Another writer got here first
+
+    rotating = true;
+    ++file_sink.index;
+    log_segment* next{ open_segment(now) };
+    rotating = false;
+
+    // Without a new file the sink stops, and everything carries on going to the console
+    segment.store(next);
+    if (!next)
+        console_level.store(log_level::trace, std::memory_order_relaxed);
+    retire(full);
+}
+
+void write_file(const char* line, u64 length, std::time_t t)
+{
+    if (rotating)
+        return;
+
+    while (log_segment* current{ segment.load() })
+    {
+        // Announce the write before checking the segment is still current; rotate swaps first and then waits for
+        // writers, so one of the two always sees the other
+        current->writers.fetch_add(1);
+        if (segment.load() != current)
+        {
+            current->writers.fetch_sub(1);
+            continue;
+        }
+
+        if (!current->rotate_at || t < current->rotate_at)
+        {
+            const u64 at{ current->reserved.fetch_add(length, std::memory_order_relaxed) };
+            if (at + length <= current->file.size)
+            {
+                memcpy(current->file.data + at, line, length);
+                current->writers.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+
+            // Space is claimed in order, so the first line that didn't fit marks the end of what was written
+            u64 end{ current->end.load(std::memory_order_relaxed) };
+            while (at < end && !current->end.compare_exchange_weak(end, at, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        current->writers.fetch_sub(1, std::memory_order_release);
+        rotate(current, t);
+    }
+}
+
+void write_line(log_level::level lvl, std::time_t t, const char* msg)
+{
+    thread_local char line[max_message + 64];
+    const u64         length{ format_line(line, sizeof(line), lvl, t, msg) };
+
+    write_file(line, length, t);
+    if (lvl < console_level.load(std::memory_order_relaxed))
+        return;
+
+    const bool is_error = lvl > log_level::warn;
     if (is_error)
     {
-        platform::write_error(str.c_str(), lvl);
+        platform::write_error(line, lvl);
     } else
     {
-        platform::write_message(str.c_str(), lvl);
+        platform::write_message(line, lvl);
+    }
+}
+
+template<typename T>
+bool read_raw(const u8*& in, const u8* end, T& value)
+{
+    if ((u64) (end - in) < sizeof(T))
+        return false;
+
+    memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return true;
+}
+
+u32 decode_args(const u8* in, u32 size, decoded_arg* args)
+{
+    const u8* end{ in + size };
+    u32       count = 0;
+    while (in < end && count < max_args)
+    {
+        decoded_arg& arg{ args[count++] };
+        arg.type = (detail::arg_type::type) in[0];
+        ++in;
+        arg.bits = 0;
+        switch (arg.type)
+        {
+        case detail::arg_type::boolean:
+        case detail::arg_type::character:
+            if (!read_raw(in, end, *(u8*) &arg.bits))
+                return u32_invalid;
+            break;
+        case detail::arg_type::float32:
+            if (!read_raw(in, end, *(u32*) &arg.bits))
+                return u32_invalid;
+            break;
+        case detail::arg_type::signed_int:
+        case detail::arg_type::unsigned_int:
+        case detail::arg_type::float64:
+        case detail::arg_type::pointer:
+            if (!read_raw(in, end, arg.bits))
+                return u32_invalid;
+            break;
+        case detail::arg_type::string:
+        {
+            u16 length{};
+            if (!read_raw(in, end, length) || (u64) (end - in) < length)
+                return u32_invalid;
+            arg.str = { (const char*) in, length };
+            in += length;
+        }
+        break;
+        default: return u32_invalid;
+        }
+    }
+    return count;
+}
+
+template<typename T>
+void format_as(std::string& out, const std::string& spec, T value)
+{
+    std::vformat_to(std::back_inserter(out), spec, std::make_format_args(value));
+}
+
+void format_arg(std::string& out, const decoded_arg& arg, std::string_view spec)
+{
+    const std::string field{ spec.empty() ? "{}" : std::format("{{:{}}}", spec) };
+    try
+    {
+        switch (arg.type)
+        {
+        case detail::arg_type::boolean: format_as(out, field, arg.bits != 0); break;
+        case detail::arg_type::character: format_as(out, field, (char) arg.bits); break;
+        case detail::arg_type::signed_int: format_as(out, field, (i64) arg.bits); break;
+        case detail::arg_type::unsigned_int: format_as(out, field, arg.bits); break;
+        case detail::arg_type::float32: format_as(out, field, std::bit_cast<f32>((u32) arg.bits)); break;
+        case detail::arg_type::float64: format_as(out, field, std::bit_cast<f64>(arg.bits)); break;
+        case detail::arg_type::string: format_as(out, field, arg.str); break;
+        case detail::arg_type::pointer: format_as(out, field, (const void*) (uintptr_t) arg.bits); break;
+        }
+    } catch (const std::format_error&)
+    {
+        out += "{?}";
+    }
+}
+
+// Does what std::format did for the caller, one replacement field at a time, since the argument types are only known
+// at runtime. Nested fields (e.g. a width taken from an argument) aren't supported
+std::string format_binary(const char* format, const u8* raw, u32 size)
+{
+    decoded_arg args[max_args];
+    const u32   count{ decode_args(raw, size, args) };
+    if (count == u32_invalid)
+        return std::format("<damaged binary message for '{}'>", format);
+
+    const std::string_view fmt{ format };
+    std::string            out;
+    u32                    next = 0;
+    for (u64 i = 0; i < fmt.size();)
+    {
+        const char c{ fmt[i] };
+        if ((c == '{' || c == '}') && i + 1 < fmt.size() && fmt[i + 1] == c)
+        {
+            out += c;
+            i += 2;
+            continue;
+        }
+
+        if (c != '{')
+        {
+            out += c;
+            ++i;
+            continue;
+        }
+
+        const u64 close{ fmt.find('}', i) };
+        if (close == std::string_view::npos)
+        {
+            out += fmt.substr(i);
+            break;
+        }
+
+        const std::string_view field{ fmt.substr(i + 1, close - i - 1) };
+        const u64              colon{ field.find(':') };
+        const std::string_view index{ field.substr(0, colon) };
+        const std::string_view spec{ colon == std::string_view::npos ? std::string_view{} : field.substr(colon + 1) };
+
+        u32 arg = next++;
+        if (!index.empty())
+            std::from_chars(index.data(), index.data() + index.size(), arg);
+
+        if (arg < count)
+            format_arg(out, args[arg], spec);
+        else
+            out += "{?}";
+
+        i = close + 1;
+    }
+    return out;
+}
+
+template<typename T>
+void stage(const T& value)
+{
+    async.staged.append((const char*) &value, sizeof(T));
+}
+
+void stage_record(const log_cell& cell)
+{
+    if (cell.binary && !async.formats_written[cell.format])
+    {
+        const char* format{ format_keys[cell.format].load(std::memory_order_acquire) };
+        const u16   length{ (u16) strlen(format) };
+        stage(chunk::format);
+        stage(cell.format);
+        stage(length);
+        async.staged.append(format, length);
+        async.formats_written[cell.format] = true;
+    }
+
+    stage(cell.binary ? chunk::binary : chunk::text);
+    stage((u8) cell.level);
+    stage((i64) cell.time);
+    if (cell.binary)
+        stage(cell.format);
+    stage(cell.length);
+    async.staged.append((const char*) cell.data, cell.length);
+}
+
+void write_staged()
+{
+    if (async.staged.empty())
+        return;
+
+    u64 size{};
+    utl::fs::write(async.file, async.staged.size(), async.staged.data(), size);
+    async.staged.clear();
+}
+
+// Returns false if the buffer is full and the policy says not to wait
+bool push(log_level::level lvl, const void* data, u32 length, bool binary, u32 format)
+{
+    u64       pos{ head.load(std::memory_order_relaxed) };
+    log_cell* cell{};
+    for (;;)
+    {
+        cell = &async.cells[pos & async.mask];
+        const u64 sequence{ cell->sequence.load(std::memory_order_acquire) };
+        const i64 diff{ (i64) sequence - (i64) pos };
+        if (diff == 0)
+        {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0)
+        {
+            // The sink hasn't written this lap yet
+            if (async.policy != overflow_policy::block)
+                return false;
+
+            std::this_thread::yield();
+            pos = head.load(std::memory_order_relaxed);
+        } else
+        {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    memcpy(cell->data, data, length);
+    if (!binary)
+        cell->data[length] = 0;
+    cell->length = (u16) length;
+    cell->binary = binary;
+    cell->format = format;
+    cell->level  = lvl;
+    cell->time   = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void enqueue(log_level::level lvl, const void* data, u32 length, bool binary, u32 format)
+{
+    if (!push(lvl, data, length, binary, format))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        if (async.policy == overflow_policy::count)
+            unreported.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Whatever comes next may well be a crash, so make sure this got out
+    if (lvl == log_level::fatal)
+        flush();
+}
+
+// Writes everything that's ready. Only ever called from the sink thread, or after it has been joined
+void drain(u64& tail)
+{
+    for (;;)
+    {
+        log_cell& cell{ async.cells[tail & async.mask] };
+        if (cell.sequence.load(std::memory_order_acquire) != tail + 1)
+            break;
+
+        if (async.has_file)
+            stage_record(cell);
+
+        if (!async.has_file || cell.level >= log_level::warn)
+        {
+            if (cell.binary)
+            {
+                const char* format{ format_keys[cell.format].load(std::memory_order_acquire) };
+                write_line(cell.level, cell.time, format_binary(format, cell.data, cell.length).c_str());
+            } else
+            {
+                write_line(cell.level, cell.time, (const char*) cell.data);
+            }
+        }
+
+        cell.sequence.store(tail + async.mask + 1, std::memory_order_release);
+        ++tail;
+
+        // Staged chunks must be in the file before a flush waiting on this message returns
+        if (cell.level == log_level::fatal && async.has_file)
+            write_staged();
+        written.store(tail, std::memory_order_release);
+    }
+
+    if (const u64 lost{ unreported.exchange(0, std::memory_order_relaxed) })
+    {
+        const std::string msg{ std::format("{} log messages were dropped because the async buffer was full", lost) };
+        write_line(log_level::warn, std::time(nullptr), msg.c_str());
+    }
+
+    if (async.has_file)
+        write_staged();
+}
+
+void sink_loop(u64 tail)
+{
+    for (;;)
+    {
+        drain(tail);
+
+        std::unique_lock lock{ async.mutex };
+        if (async.quit)
+            break;
+
+        // Producers never signal, so the hot path stays free of syscalls. Waking up now and then is cheap enough
+        async.wake.wait_for(lock, std::chrono::milliseconds{ 1 });
+    }
+
+    drain(tail);
+}
+
+// Held while using the ring, so stop_async can wait for everyone using it before freeing it. Both sides use
+// sequentially consistent operations: either the user sees async mode stopped, or stop_async sees the user
+struct async_user
+{
+    async_user() { async_users.fetch_add(1); }
+    ~async_user() { async_users.fetch_sub(1); }
+
+    [[nodiscard]] bool running() const { return async_running.load(); }
+};
+
+void deliver(log_level::level lvl, const char* msg)
+{
+    if (const async_user user{}; user.running())
+    {
+        if (const u64 length{ strlen(msg) }; length < max_async_message)
+        {
+            enqueue(lvl, msg, (u32) length, false, 0);
+            return;
+        }
+
+        // Too long for a cell, so it's written here once everything before it is out rather than cut short
+        flush();
+    }
+
+    write_line(lvl, std::time(nullptr), msg);
+    if (lvl == log_level::fatal)
+        flush();
+}
+
+void deliver_binary(log_level::level lvl, u32 format, const u8* args, u32 size)
+{
+    // Async mode may have stopped since the caller checked
+    if (const async_user user{}; user.running())
+    {
+        enqueue(lvl, args, size, true, format);
+        return;
+    }
+
+    const char* fmt{ format_keys[format].load(std::memory_order_acquire) };
+    write_line(lvl, std::time(nullptr), format_binary(fmt, args, size).c_str());
+}
+
+u64 hash_bytes(const void* data, u64 size, u64 seed = 0)
+{
+    u64 hash{ 0xcbf29ce484222325ull ^ seed };
+    for (u64 i = 0; i < size; ++i)
+        hash = (hash ^ ((const u8*) data)[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+void report_repeats(repeat_state& last, std::time_t now)
+{
+    char message[64];
+    *std::format_to_n(message, sizeof(message) - 1, "Previous message repeated {} times", last.repeats).out = 0;
+    last.repeats = 0;
+    last.since   = now;
+    deliver(last.level, message);
+}
+
+// Reports the calling thread's repeats without waiting for its next message, which may never come
+void report_pending_repeats()
+{
+    if (last_message.repeats)
+        report_repeats(last_message, std::time(nullptr));
+}
+
+// True if the message is the same as the last one from this thread, in which case it's only counted
+bool repeated(log_level::level lvl, u64 hash)
+{
+    if (!deduplicate.load(std::memory_order_relaxed))
+        return false;
+
+    const std::time_t now{ std::time(nullptr) };
+    if (hash == last_message.hash && lvl == last_message.level && lvl != log_level::fatal)
+    {
+        if (!last_message.repeats)
+            last_message.since = now;
+        ++last_message.repeats;
+        _suppressed.fetch_add(1, std::memory_order_relaxed);
+
+        // A storm that never lets up still gets reported now and then
+        if (now - last_message.since >= 1)
+            report_repeats(last_message, now);
+        return true;
+    }
+
+    if (last_message.repeats)
+        report_repeats(last_message, now);
+
+    last_message.hash  = hash;
+    last_message.level = lvl;
+    return false;
+}
+
+repeat_state::~repeat_state()
+{
+    if (repeats)
+        report_repeats(*this, std::time(nullptr));
+}
+
+bool decode_chunks(const char* path, std::span<const u8> data, func_on_line on_line, void* user_data)
+{
+    const u8* in{ data.data() };
+    const u8* end{ in + data.size() };
+    u32       header[2]{};
+    if (!read_raw(in, end, header) || header[0] != binary_magic || header[1] != binary_version)
+    {
+        LOG_ERROR("{} is not a binary log this version can read", path);
+        return false;
+    }
+
+    const std::unique_ptr<std::string[]> formats{ new std::string[max_formats] };
+    while (in < end)
+    {
+        u8  tag{};
+        u8  level{};
+        i64 time{};
+        u32 id{};
+        u16 length{};
+        read_raw(in, end, tag);
+
+        const bool ok{ tag == chunk::format
+                           ? read_raw(in, end, id) && read_raw(in, end, length)
+                           : read_raw(in, end, level) && read_raw(in, end, time) &&
+                                 (tag != chunk::binary || read_raw(in, end, id)) && read_raw(in, end, length) };
+        if (!ok || (tag != chunk::format && tag != chunk::binary && tag != chunk::text) || id >= max_formats ||
+            level > log_level::fatal || (u64) (end - in) < length)
+        {
+            LOG_ERROR("{} is damaged at offset {}", path, (u64) (in - data.data()));
+            return false;
+        }
+
+        if (tag == chunk::format)
+        {
+            formats[id].assign((const char*) in, length);
+        } else
+        {
+            const std::string msg{ tag == chunk::binary ? format_binary(formats[id].c_str(), in, length)
+                                                        : std::string{ (const char*) in, length } };
+            char line[max_message + 64];
+            format_line(line, sizeof(line), (log_level::level) level, time, msg.c_str());
+            on_line((log_level::level) level, line, user_data);
+        }
+        in += length;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+std::atomic<u8> _category_levels[log_category::count]{ default_level, default_level, default_level, default_level,
+                                                       default_level, default_level, default_level };
+std::atomic<u32> _rate_limit{ 100 };
+std::atomic<u64> _suppressed{};
+
+bool start_async(const async_desc& desc)
+{
+    if (async_running.load(std::memory_order_acquire))
+        return false;
+
+    async.has_file = false;
+    if (desc.binary && desc.binary_path)
+    {
+        if (!utl::fs::open(desc.binary_path, utl::fs::file_modes::write, true, async.file))
+        {
+            LOG_ERROR("Failed to open binary log {}", desc.binary_path);
+            return false;
+        }
+
+        const u32 header[2]{ binary_magic, binary_version };
+        u64       size{};
+        utl::fs::write(async.file, sizeof(header), header, size);
+        std::fill_n(async.formats_written, max_formats, false);
+        async.has_file = true;
+    }
+
+    const u32 capacity{ std::bit_ceil(std::max(desc.capacity, 2u)) };
+    async.cells = new log_cell[capacity]{};
+    for (u32 i = 0; i < capacity; ++i)
+        async.cells[i].sequence.store(i, std::memory_order_relaxed);
+
+    async.mask   = capacity - 1;
+    async.policy = desc.policy;
+    async.binary = desc.binary;
+    async.quit   = false;
+    head.store(0, std::memory_order_relaxed);
+    written.store(0, std::memory_order_relaxed);
+
+    // Writing to the console is the least urgent work there is, so keep it off the performance cores when possible
+    const threading::cpu_set affinity{ threading::cores_of_kind(threading::core_kind::efficiency, false) };
+    async.sink = threading::create_thread({ "Log Sink", affinity }, [] { sink_loop(0); });
+    if (!async.sink.joinable())
+    {
+        delete[] async.cells;
+        async.cells = nullptr;
+        if (async.has_file)
+            utl::fs::close(async.file);
+        return false;
+    }
+
+    async_running.store(true, std::memory_order_release);
+    return true;
+}
+
+void stop_async()
+{
+    report_pending_repeats();
+    if (!async_running.exchange(false))
+        return;
+
+    // Whoever is still pushing finishes first, so the sink's last drain writes their messages too
+    while (async_users.load())
+        std::this_thread::yield();
+
+    {
+        std::lock_guard lock{ async.mutex };
+        async.quit = true;
+    }
+    async.wake.notify_one();
+    async.sink.join();
+
+    delete[] async.cells;
+    async.cells = nullptr;
+    if (async.has_file)
+    {
+        utl::fs::close(async.file);
+        async.has_file = false;
+    }
+}
+
+void flush()
+{
+    report_pending_repeats();
+    if (const async_user user{}; user.running())
+    {
+        const u64 target{ head.load(std::memory_order_acquire) };
+        async.wake.notify_one();
+        while (written.load(std::memory_order_acquire) < target)
+            std::this_thread::yield();
+    }
+
+    // Lines in the mapped file already outlive the process, this gets them to disk in case the machine goes down too
+    std::lock_guard lock{ file_sink.mutex };
+    if (const log_segment* current{ segment.load() })
+        platform::flush_mapped(current->file, false);
+}
+
+u64 dropped_count()
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+bool start_file_sink(const file_sink_desc& desc)
+{
+    std::lock_guard lock{ file_sink.mutex };
+    if (segment.load() || !desc.path || !desc.max_files)
+        return false;
+
+    const std::filesystem::path path{ desc.path };
+    file_sink.stem      = path.parent_path() / path.stem();
+    file_sink.extension = path.extension();
+    file_sink.max_size  = std::max<u64>(desc.max_size, max_message + 64); // Any one line has to fit
+    file_sink.max_age   = desc.max_age;
+    file_sink.max_files = desc.max_files;
+
+    // Carry on numbering from the last run, so its logs are kept until they rotate out
+    file_sink.index = 0;
+    utl::vector<u32> existing{};
+    std::error_code  error;
+    const std::filesystem::path directory{ path.parent_path().empty() ? "." : path.parent_path() };
+    const std::string prefix{ path.stem().string() + "." };
+    for (const auto& entry : std::filesystem::directory_iterator{ directory, error })
+    {
+        const std::filesystem::path name{ entry.path().filename() };
+        const std::string           stem{ name.stem().string() };
+        if (name.extension() != file_sink.extension || !stem.starts_with(prefix))
+            continue;
+
+        u32        index{};
+        const auto number{ std::string_view{ stem }.substr(prefix.size()) };
+        if (std::from_chars(number.data(), number.data() + number.size(), index).ptr == number.data() + number.size())
+        {
+            existing.push_back(index);
+            file_sink.index = std::max(file_sink.index, index + 1);
+        }
+    }
+
+    // Make room for the new file the same way rotating does
+    for (const u32 index : existing)
+    {
+        if (index + file_sink.max_files <= file_sink.index)
+            std::filesystem::remove(segment_path(index), error);
+    }
+
+    log_segment* first{ open_segment(std::time(nullptr)) };
+    if (!first)
+        return false;
+
+    console_level.store(desc.console_level, std::memory_order_relaxed);
+    segment.store(first);
+    return true;
+}
+
+void stop_file_sink()
+{
+    report_pending_repeats();
+    std::lock_guard lock{ file_sink.mutex };
+    log_segment*    current{ segment.exchange(nullptr) };
+    if (!current)
+        return;
+
+    console_level.store(log_level::trace, std::memory_order_relaxed);
+    retire(current);
+    for (log_segment* old : file_sink.retired)
+        delete old;
+    file_sink.retired.clear();
+}
+
+bool decode_binary_log(const char* path, func_on_line on_line, void* user_data)
+{
+    utl::fs::mapped_file file{};
+    if (!utl::fs::map(path, file, utl::fs::map_hints::sequential))
+    {
+        LOG_ERROR("Failed to open binary log {}", path);
+        return false;
     }
+
+    const bool decoded{ decode_chunks(path, file.bytes(), on_line, user_data) };
+    utl::fs::unmap(file);
+    return decoded;
+}
+
+void set_level(log_category::category category, log_level::level lvl)
+{
+    sky_assert(category < log_category::count);
+    _category_levels[category].store(lvl, std::memory_order_relaxed);
+}
+
+log_level::level get_level(log_category::category category)
+{
+    sky_assert(category < log_category::count);
+    return (log_level::level) _category_levels[category].load(std::memory_order_relaxed);
+}
+
+void set_all_levels(log_level::level lvl)
+{
+    for (auto& level : _category_levels)
+        level.store(lvl, std::memory_order_relaxed);
+}
+
+bool configure(const char* spec)
+{
+    std::string_view rest{ spec ? spec : "" };
+    while (!rest.empty())
+    {
+        const u64              comma{ rest.find(',') };
+        const std::string_view item{ rest.substr(0, comma) };
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+        if (item.empty())
+            continue;
+
+        const u64        equals{ item.find('=') };
+        log_level::level lvl;
+        if (!parse_level(equals == std::string_view::npos ? item : item.substr(equals + 1), lvl))
+        {
+            LOG_ERROR("Unknown log level in '{}'", item);
+            return false;
+        }
+
+        if (equals == std::string_view::npos)
+        {
+            set_all_levels(lvl);
+            continue;
+        }
+
+        const std::string_view name{ item.substr(0, equals) };
+        const auto             found{ std::find(std::begin(category_names), std::end(category_names), name) };
+        if (found == std::end(category_names))
+        {
+            LOG_ERROR("Unknown log category in '{}'", item);
+            return false;
+        }
+        set_level((log_category::category) (found - std::begin(category_names)), lvl);
+    }
+    return true;
+}
+
+const char* category_name(log_category::category category)
+{
+    return category < log_category::count ? category_names[category] : "unknown";
+}
+
+void set_rate_limit(u32 per_second)
+{
+    _rate_limit.store(per_second, std::memory_order_relaxed);
+}
+
+void set_deduplicate(bool enabled)
+{
+    deduplicate.store(enabled, std::memory_order_relaxed);
+}
+
+u64 suppressed_count()
+{
+    return _suppressed.load(std::memory_order_relaxed);
+}
+
+void _report_suppressed(log_level::level lvl, const char* fmt, u32 count)
+{
+    char message[256];
+    *std::format_to_n(message, sizeof(message) - 1, "Suppressed {} more messages like \"{}\"", count, fmt).out = 0;
+    deliver(lvl, message);
+}
+
+void _send_message(log_level::level lvl, const char* msg)
+{
+    if (!repeated(lvl, hash_bytes(msg, strlen(msg))))
+        deliver(lvl, msg);
+}
+
+bool _binary_enabled()
+{
+    return async_running.load(std::memory_order_acquire) && async.binary;
+}
+
+u32 _format_id(const char* fmt)
+{
+    const u64 hash{ (u64) (uintptr_t) fmt * 0x9e3779b97f4a7c15ull };
+    u32       slot{ (u32) (hash >> 52) & (max_formats - 1) };
+    for (u32 probe = 0; probe < max_formats; ++probe, slot = (slot + 1) & (max_formats - 1))
+    {
+        const char* key{ format_keys[slot].load(std::memory_order_acquire) };
+        if (key == fmt)
+            return slot;
+
+        if (!key)
+        {
+            const char* expected{ nullptr };
+            if (format_keys[slot].compare_exchange_strong(expected, fmt, std::memory_order_acq_rel) || expected == fmt)
+                return slot;
+        }
+    }
+
+    // Out of ids, so this format is sent as text from now on
+    return u32_invalid;
+}
+
+void _send_binary(log_level::level lvl, u32 format, const u8* args, u32 size)
+{
+    if (!repeated(lvl, hash_bytes(args, size, format)))
+        deliver_binary(lvl, format, args, size);
 }
 } // namespace sky::logger
 
@@ -26,7 +26,13 @@
 
 #include "Skyborn/Defines.h"
 
+#include <atomic>
+#include <cstring>
+#include <ctime>
 #include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace sky::logger
 {
@@ -43,27 +49,400 @@ struct log_level
     };
 };
 
+// Subsystems with their own verbosity. Each translation unit logs to SKY_LOG_CATEGORY, general unless it defines it
+// before its includes; LOG_CAT picks one per call
+struct log_category
+{
+    enum category : u8
+    {
+        general,
+        platform,
+        input,
+        renderer,
+        vulkan,
+        validation, // Messages from the Vulkan validation layers
+        frame,      // Per frame stats, e.g. FPS
+
+        count
+    };
+};
+
+// MSVC's STL only exposes the checked format string under its internal name
+#ifdef _MSVC_STL_VERSION
+template<class... Args>
+using format_string = std::_Fmt_string<Args...>;
+
+    #define SKY_FORMAT_STR(fmt) (fmt)._Str
+#else
 template<class... Args>
-void send_message(log_level::level lvl, const std::_Fmt_string<Args...> fmt, Args&&... args)
+using format_string = std::format_string<Args...>;
+
+    #define SKY_FORMAT_STR(fmt) (fmt).get()
+#endif
+
+// What a full async buffer does with a new message
+struct overflow_policy
 {
-    std::string str = std::vformat(fmt._Str, std::make_format_args(args...));
-    _send_message(lvl, str.c_str());
+    enum policy : u8
+    {
+        drop,  // Discard it silently
+        block, // Wait for the sink thread to make room
+        count, // Discard it and report how many were lost once there's room again
+    };
+};
+
+struct async_desc
+{
+    u32                     capacity{ 4096 }; // Messages the buffer holds. Rounded up to a power of two
+    overflow_policy::policy policy{ overflow_policy::count };
+
+    // Callers store the format string's id and the raw arguments instead of formatting, leaving it to the sink.
+    // Messages with arguments that can't be stored raw are still formatted by the caller
+    bool binary{ false };
+
+    // With binary, every message goes to this file unformatted, to be turned into text by LogDecoder. Only warnings
+    // and up still reach the console
+    const char* binary_path{};
+};
+
+// Longer messages are truncated
+constexpr u32 max_message = 4096;
+
+// Longer messages are written by the caller in async mode, after waiting for the buffer to drain. Binary messages
+// that don't fit are formatted by the caller instead
+constexpr u32 max_async_message = 256;
+
+/**
+ * Hands messages to a background thread instead of writing them on the calling thread. Callers only format the
+ * message and copy it into a lock-free buffer; the timestamp, prefix and console write happen on the sink thread
+ * @param desc Buffer size and what to do when it's full
+ * @return true if async mode started, false if it was already running or the thread couldn't start
+ */
+SAPI bool start_async(const async_desc& desc = {});
+
+// Writes everything still buffered, then goes back to writing on the calling thread. Other threads may keep logging
+// meanwhile; stop_async waits for the messages they're in the middle of pushing, and later ones are written directly
+SAPI void stop_async();
+
+// Blocks until everything logged before the call has been written. Called on every fatal message
+SAPI void flush();
+
+// Messages discarded because the async buffer was full
+[[nodiscard]] SAPI u64 dropped_count();
+
+struct file_sink_desc
+{
+    // Files are numbered before the extension, e.g. skyborn.0.log, carrying on from the highest one already there
+    const char* path{ "skyborn.log" };
+    u64         max_size{ 64_MB }; // Each file is preallocated to this and rotated once full
+    u32         max_age{};         // Seconds before rotating regardless of size, 0 for never
+    u32         max_files{ 8 };    // Older files are deleted
+
+    // Less severe messages only go to the file, keeping the console quiet on soak runs
+    log_level::level console_level{ log_level::trace };
+};
+
+/**
+ * Also writes every text line to memory-mapped, preallocated files. Writers claim space with an atomic add and copy
+ * the line in, so there's no syscall per message and lines already written survive a crash
+ * @param desc Where the files go and when to rotate them
+ * @return true if the first file was mapped, false if it couldn't be or the sink is already running
+ */
+SAPI bool start_file_sink(const file_sink_desc& desc = {});
+
+// Unmaps the current file, trimmed to what was written. Other threads should be done logging
+SAPI void stop_file_sink();
+
+using func_on_line = void (*)(log_level::level lvl, const char* line, void* user_data);
+
+/**
+ * Turns a binary log written through async_desc::binary_path back into text
+ * @param path The binary log
+ * @param on_line Called with each message, prefixed and newline terminated like the console output, in order
+ * @param user_data Handed to on_line
+ * @return true if the whole file was decoded, false if it couldn't be read or is damaged
+ */
+SAPI bool decode_binary_log(const char* path, func_on_line on_line, void* user_data);
+
+/**
+ * Sets the least severe level a category writes. Levels below its compile-time minimum stay stripped
+ * @param category The subsystem
+ * @param lvl Least severe level written from now on
+ */
+SAPI void set_level(log_category::category category, log_level::level lvl);
+[[nodiscard]] SAPI log_level::level get_level(log_category::category category);
+
+// Sets every category's level at once
+SAPI void set_all_levels(log_level::level lvl);
+
+/**
+ * Sets levels from a spec like "warn,vulkan=trace,frame=info". A bare level applies to every category. Names are
+ * the category and level enumerators. Application::create reads it from the SKY_LOG environment variable
+ * @param spec Comma separated assignments
+ * @return true if all of it was understood. Assignments before a bad one still apply
+ */
+SAPI bool configure(const char* spec);
+
+[[nodiscard]] SAPI const char* category_name(log_category::category category);
+
+// Runtime levels, read inline by LOG_CAT so filtered messages cost a load and a compare. Use set_level
+SAPI extern std::atomic<u8> _category_levels[log_category::count];
+
+[[nodiscard]] inline bool is_enabled(log_category::category category, log_level::level lvl)
+{
+    return lvl >= _category_levels[category].load(std::memory_order_relaxed);
 }
 
+/**
+ * Caps how many messages each call site writes per second. The rest are counted, and the next message from the
+ * site after the second is up is preceded by how many were suppressed. Fatal messages are never limited
+ * @param per_second Messages per call site per second, 0 for no limit. Defaults to 100
+ */
+SAPI void set_rate_limit(u32 per_second);
+
+// While on (the default), a message identical to the last one from the same thread is counted instead of written,
+// and "repeated N times" is written when something else comes along, once a second while the repeats go on, or when
+// the thread flushes, stops a sink or exits
+SAPI void set_deduplicate(bool deduplicate);
+
+// Messages dropped by rate limiting or deduplication
+[[nodiscard]] SAPI u64 suppressed_count();
+
+SAPI extern std::atomic<u32> _rate_limit;
+SAPI extern std::atomic<u64> _suppressed;
+SAPI void                    _report_suppressed(log_level::level lvl, const char* fmt, u32 count);
+
+namespace detail
+{
+// Per call site state of the rate limit. LOG_CAT keeps one in a static, constant initialized so it costs no guard
+struct call_site
+{
+    std::atomic<u32> second{};
+    std::atomic<u32> count{};
+    std::atomic<u32> suppressed{};
+
+    bool allow(log_level::level lvl, const char* fmt)
+    {
+        const u32 limit{ _rate_limit.load(std::memory_order_relaxed) };
+        if (!limit || lvl == log_level::fatal)
+            return true;
+
+        const u32 now{ (u32) std::time(nullptr) };
+        u32       last{ second.load(std::memory_order_relaxed) };
+        if (last != now && second.compare_exchange_strong(last, now, std::memory_order_relaxed))
+        {
+            count.store(0, std::memory_order_relaxed);
+            if (const u32 missed{ suppressed.exchange(0, std::memory_order_relaxed) })
+                _report_suppressed(lvl, fmt, missed);
+        }
+
+        if (count.fetch_add(1, std::memory_order_relaxed) < limit)
+            return true;
+
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        _suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+};
+} // namespace detail
+
 SAPI void _send_message(log_level::level lvl, const char* msg);
 
+// Binary logging hooks for send_message
+SAPI bool _binary_enabled();
+SAPI u32  _format_id(const char* fmt);
+SAPI void _send_binary(log_level::level lvl, u32 format, const u8* args, u32 size);
+
+namespace detail
+{
+// Tags each raw argument in a binary message
+struct arg_type
+{
+    enum type : u8
+    {
+        boolean,
+        character,
+        signed_int,
+        unsigned_int,
+        float32,
+        float64,
+        string,
+        pointer,
+    };
+};
+
+template<typename T>
+concept string_like = std::is_same_v<T, const char*> || std::is_same_v<T, char*> || std::is_same_v<T, std::string> ||
+                      std::is_same_v<T, std::string_view> ||
+                      (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>);
+
+// Anything else, e.g. types with their own formatter, is formatted by the caller
+template<typename T>
+concept raw_arg = std::is_same_v<T, bool> || std::is_same_v<T, char> ||
+                  (std::is_integral_v<T> && sizeof(T) <= sizeof(u64) && !std::is_same_v<T, wchar_t>) ||
+                  std::is_same_v<T, f32> || std::is_same_v<T, f64> || string_like<T> ||
+                  (std::is_pointer_v<T> && std::is_void_v<std::remove_cv_t<std::remove_pointer_t<T>>>);
+
+// Messages are formatted here rather than into a new string, so logging doesn't allocate
+inline char* thread_buffer()
+{
+    thread_local char buffer[max_message];
+    return buffer;
+}
+
+inline bool put(u8* out, u32& size, arg_type::type type, const void* data, u32 bytes)
+{
+    if (size + 1 + bytes > max_async_message)
+        return false;
+
+    out[size++] = type;
+    memcpy(out + size, data, bytes);
+    size += bytes;
+    return true;
+}
+
+template<typename T>
+bool encode(u8* out, u32& size, const T& value)
+{
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool> || std::is_same_v<U, char>)
+    {
+        const u8 byte{ (u8) value };
+        return put(out, size, std::is_same_v<U, bool> ? arg_type::boolean : arg_type::character, &byte, 1);
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+    {
+        const i64 v{ value };
+        return put(out, size, arg_type::signed_int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<U>)
+    {
+        const u64 v{ value };
+        return put(out, size, arg_type::unsigned_int, &v, sizeof(v));
+    } else if constexpr (std::is_same_v<U, f32>)
+    {
+        return put(out, size, arg_type::float32, &value, sizeof(value));
+    } else if constexpr (std::is_same_v<U, f64>)
+    {
+        return put(out, size, arg_type::float64, &value, sizeof(value));
+    } else if constexpr (std::is_pointer_v<U> && !string_like<U>)
+    {
+        const u64 v{ (u64) (uintptr_t) value };
+        return put(out, size, arg_type::pointer, &v, sizeof(v));
+    } else
+    {
+        const std::string_view str{ value };
+        const u16              length{ (u16) str.size() };
+        if (str.size() > max_async_message || !put(out, size, arg_type::string, &length, sizeof(length)))
+            return false;
+        if (size + length > max_async_message)
+            return false;
+
+        memcpy(out + size, str.data(), length);
+        size += length;
+        return true;
+    }
+}
+} // namespace detail
+
+template<class... Args>
+void send_message(log_level::level lvl, const format_string<Args...> fmt, Args&&... args)
+{
+    if constexpr ((detail::raw_arg<std::remove_cvref_t<Args>> && ...))
+    {
+        if (_binary_enabled())
+        {
+            u8  raw[max_async_message];
+            u32 size{};
+            if ((detail::encode(raw, size, args) && ...))
+            {
+                // Format strings are literals, so the pointer identifies the call site's format for the whole run
+                if (const u32 id{ _format_id(SKY_FORMAT_STR(fmt).data()) }; id != u32_invalid)
+                {
+                    _send_binary(lvl, id, raw, size);
+                    return;
+                }
+            }
+        }
+    }
+
+    char* buffer{ detail::thread_buffer() };
+    *std::format_to_n(buffer, max_message - 1, fmt, std::forward<Args>(args)...).out = 0;
+    _send_message(lvl, buffer);
+}
+
 } // namespace sky::logger
 
-#ifdef _DEBUG
-    #define LOG_TRACE(msg, ...) sky::logger::send_message(sky::logger::log_level::trace, msg, ##__VA_ARGS__)
-    #define LOG_DEBUG(msg, ...) sky::logger::send_message(sky::logger::log_level::debug, msg, ##__VA_ARGS__)
-#else
-    #define LOG_TRACE(msg, ...)
-    #define LOG_DEBUG(msg, ...)
+// Compile-time minimum levels. Calls below them are removed entirely, though their arguments are still checked.
+// SKY_LOG_MIN_LEVEL sets the default for every category, SKY_LOG_MIN_LEVEL_<CATEGORY> overrides one, both as
+// log_level values. Without them, debug builds keep everything and others strip trace and debug
+#ifndef SKY_LOG_MIN_LEVEL
+    #ifdef _DEBUG
+        #define SKY_LOG_MIN_LEVEL 0
+    #else
+        #define SKY_LOG_MIN_LEVEL 2
+    #endif
+#endif
+
+#ifndef SKY_LOG_MIN_LEVEL_GENERAL
+    #define SKY_LOG_MIN_LEVEL_GENERAL SKY_LOG_MIN_LEVEL
+#endif
+#ifndef SKY_LOG_MIN_LEVEL_PLATFORM
+    #define SKY_LOG_MIN_LEVEL_PLATFORM SKY_LOG_MIN_LEVEL
+#endif
+#ifndef SKY_LOG_MIN_LEVEL_INPUT
+    #define SKY_LOG_MIN_LEVEL_INPUT SKY_LOG_MIN_LEVEL
+#endif
+#ifndef SKY_LOG_MIN_LEVEL_RENDERER
+    #define SKY_LOG_MIN_LEVEL_RENDERER SKY_LOG_MIN_LEVEL
+#endif
+#ifndef SKY_LOG_MIN_LEVEL_VULKAN
+    #define SKY_LOG_MIN_LEVEL_VULKAN SKY_LOG_MIN_LEVEL
+#endif
+#ifndef SKY_LOG_MIN_LEVEL_VALIDATION
+    #define SKY_LOG_MIN_LEVEL_VALIDATION SKY_LOG_MIN_LEVEL
+#endif
+#ifndef SKY_LOG_MIN_LEVEL_FRAME
+    #define SKY_LOG_MIN_LEVEL_FRAME SKY_LOG_MIN_LEVEL
+#endif
+
+namespace sky::logger
+{
+namespace
+{
+constexpr u8 compiled_levels[log_category::count]{ SKY_LOG_MIN_LEVEL_GENERAL,  SKY_LOG_MIN_LEVEL_PLATFORM,
+                                                   SKY_LOG_MIN_LEVEL_INPUT,    SKY_LOG_MIN_LEVEL_RENDERER,
+                                                   SKY_LOG_MIN_LEVEL_VULKAN,   SKY_LOG_MIN_LEVEL_VALIDATION,
+                                                   SKY_LOG_MIN_LEVEL_FRAME };
+
+// Internal linkage, since each translation unit may be built with different minimums
+constexpr bool compiled_in(log_category::category category, log_level::level lvl)
+{
+    return lvl >= compiled_levels[category];
+}
+} // anonymous namespace
+} // namespace sky::logger
+
+#ifndef SKY_LOG_CATEGORY
+    #define SKY_LOG_CATEGORY general
 #endif
 
+// The level checks and the rate limit come before the arguments are evaluated, so filtered calls don't touch them
+#define LOG_CAT(category, lvl, msg, ...)                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if constexpr (sky::logger::compiled_in(sky::logger::log_category::category, sky::logger::log_level::lvl))      \
+        {                                                                                                              \
+            if (sky::logger::is_enabled(sky::logger::log_category::category, sky::logger::log_level::lvl))             \
+            {                                                                                                          \
+                static sky::logger::detail::call_site sky_log_site{};                                                  \
+                if (sky_log_site.allow(sky::logger::log_level::lvl, msg))                                              \
+                    sky::logger::send_message(sky::logger::log_level::lvl, msg, ##__VA_ARGS__);                        \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (false)
 
-#define LOG_INFO(msg, ...)  sky::logger::send_message(sky::logger::log_level::info, msg, ##__VA_ARGS__)
-#define LOG_WARN(msg, ...)  sky::logger::send_message(sky::logger::log_level::warn, msg, ##__VA_ARGS__)
-#define LOG_ERROR(msg, ...) sky::logger::send_message(sky::logger::log_level::error, msg, ##__VA_ARGS__)
-#define LOG_FATAL(msg, ...) sky::logger::send_message(sky::logger::log_level::fatal, msg, ##__VA_ARGS__)
\ No newline at end of file
+#define LOG_TRACE(msg, ...) LOG_CAT(SKY_LOG_CATEGORY, trace, msg, ##__VA_ARGS__)
+#define LOG_DEBUG(msg, ...) LOG_CAT(SKY_LOG_CATEGORY, debug, msg, ##__VA_ARGS__)
+#define LOG_INFO(msg, ...)  LOG_CAT(SKY_LOG_CATEGORY, info, msg, ##__VA_ARGS__)
+#define LOG_WARN(msg, ...)  LOG_CAT(SKY_LOG_CATEGORY, warn, msg, ##__VA_ARGS__)
+#define LOG_ERROR(msg, ...) LOG_CAT(SKY_LOG_CATEGORY, error, msg, ##__VA_ARGS__)
+#define LOG_FATAL(msg, ...) LOG_CAT(SKY_LOG_CATEGORY, fatal, msg, ##__VA_ARGS__)
\ No newline at end of file
@@ -48,22 +48,27 @@ using f32 = float;
 using f64 = double;
 
 // Invalid unsigned values (-1)
-constexpr u8  u8_invalid{ 0xffui8 };
-constexpr u16 u16_invalid{ 0xffffui16 };
-constexpr u32 u32_invalid{ 0xffff'ffffui32 };
-constexpr u64 u64_invalid{ 0xffff'ffff'ffff'ffffui64 };
+constexpr u8  u8_invalid{ 0xffu };
+constexpr u16 u16_invalid{ 0xffffu };
+constexpr u32 u32_invalid{ 0xffff'ffffu };
+constexpr u64 u64_invalid{ 0xffff'ffff'ffff'ffffull };
 
 // Same as above, but for situations where the value is actually valid
-constexpr u8  u8_max{ 0xffui8 };
-constexpr u16 u16_max{ 0xffffui16 };
-constexpr u32 u32_max{ 0xffff'ffffui32 };
-constexpr u64 u64_max{ 0xffff'ffff'ffff'ffffui64 };
+constexpr u8  u8_max{ 0xffu };
+constexpr u16 u16_max{ 0xffffu };
+constexpr u32 u32_max{ 0xffff'ffffu };
+constexpr u64 u64_max{ 0xffff'ffff'ffff'ffffull };
 
 #if defined(_WIN32)
     #define SKY_PLATFORM_WINDOWS 1
     #ifndef _WIN64
         #error "Skyborn only supports x64"
     #endif
+#elif defined(__linux__)
+    #define SKY_PLATFORM_LINUX 1
+    #ifndef __x86_64__
+        #error "Skyborn only supports x64"
+    #endif
 #endif
 // TODO: When I decide to work on other platforms, more macros need to be added here
 
@@ -160,18 +165,18 @@ concept constructible_from_args = std::constructible_from<T, Args...>;
 template<typename T>
 concept primitive_type = std::is_arithmetic_v<T>;
 
-constexpr auto operator""_KB(const u64 x)
+constexpr auto operator""_KB(const unsigned long long x)
 {
     return x * 1024u;
 }
 
-constexpr auto operator""_MB(const u64 x)
+constexpr auto operator""_MB(const unsigned long long x)
 {
     // x * 1024 * 1024
     return x * 1048576u;
 }
 
-constexpr auto operator""_GB(const u64 x)
+constexpr auto operator""_GB(const unsigned long long x)
 {
     // x * 1024 * 1024 * 1024
     return x * 1073741824u;
@@ -0,0 +1,131 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: CommandBuffer.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "CommandBuffer.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace sky::ecs
+{
+namespace
+{
+// Keeps every header naturally aligned within the buffer
+constexpr u64 record_alignment = 8;
+
+constexpr u64 align_up(u64 value)
+{
+    return (value + record_alignment - 1) & ~(record_alignment - 1);
+}
+
+} // anonymous namespace
+
+command_buffer::command_buffer(world& w) : m_world{ &w } {}
+
+command_buffer::~command_buffer()
+{
+    clear();
+    free(m_data);
+}
+
+entity command_buffer::create()
+{
+    const entity e{ m_world->reserve() };
+    push(op::create, e, u32_invalid, nullptr, 0);
+    return e;
+}
+
+void command_buffer::destroy(entity e)
+{
+    push(op::destroy, e, u32_invalid, nullptr, 0);
+}
+
+void command_buffer::playback()
+{
+    u64 offset = 0;
+    while (offset < m_size)
+    {
+        const auto*  h{ (const header*) (m_data + offset) };
+        const u8*    payload{ m_data + offset + sizeof(header) };
+        const entity e{ h->target };
+        void*        data{};
+
+        switch (h->type)
+        {
+        case op::create: m_world->activate(e); break;
+        case op::destroy: m_world->destroy(e); break;
+        case op::add:
+            data = m_world->add_component(e, h->component);
+            if (data && h->payload_size)
+                memcpy(data, payload, h->payload_size);
+            break;
+        case op::remove: m_world->remove_component(e, h->component); break;
+        }
+
+        offset += align_up(sizeof(header) + h->payload_size);
+    }
+
+    m_size = 0;
+}
+
+void command_buffer::clear()
+{
+    // Handles reserved by creates that never played back go back to the world
+    for (u64 offset = 0; offset < m_size;)
+    {
+        const auto* h{ (const header*) (m_data + offset) };
+        if (h->type == op::create)
+            m_world->release(h->target);
+        offset += align_up(sizeof(header) + h->payload_size);
+    }
+
+    m_size = 0;
+}
+
+void command_buffer::push(op::type type, entity e, component_id id, const void* payload, u32 size)
+{
+    const u64 record_size{ align_up(sizeof(header) + size) };
+    if (m_size + record_size > m_capacity)
+    {
+        u64 capacity{ m_capacity ? m_capacity : 1_KB };
+        while (capacity < m_size + record_size)
+            capacity *= 2;
+
+        void* data{ realloc(m_data, capacity) };
+        sky_assert(data);
+        m_data     = (u8*) data;
+        m_capacity = capacity;
+    }
+
+    auto* h{ (header*) (m_data + m_size) };
+    h->type         = type;
+    h->component    = id;
+    h->target       = e;
+    h->payload_size = size;
+    if (size)
+        memcpy(m_data + m_size + sizeof(header), payload, size);
+
+    m_size += record_size;
+}
+
+} // namespace sky::ecs
\ No newline at end of file
@@ -0,0 +1,101 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: CommandBuffer.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "World.h"
+
+namespace sky::ecs
+{
+// Records structural changes (create, destroy, add, remove) and applies them in one batch on playback.
+// Component values are copied inline into the buffer, so nothing recorded points back at the caller
+class command_buffer
+{
+public:
+    SAPI explicit command_buffer(world& w);
+    SAPI ~command_buffer();
+
+    DISABLE_COPY_AND_MOVE(command_buffer);
+
+    // The handle is valid right away and can be used in later commands, but is only alive after playback. Buffers on
+    // different threads can create at the same time
+    SAPI entity create();
+    SAPI void   destroy(entity e);
+
+    template<component_type T>
+    void add(entity e, const T& value = {})
+    {
+        push(op::add, e, component<T>(), &value, std::is_empty_v<T> ? 0 : (u32) sizeof(T));
+    }
+
+    template<component_type T>
+    void set(entity e, const T& value)
+    {
+        add(e, value);
+    }
+
+    template<component_type T>
+    void remove(entity e)
+    {
+        push(op::remove, e, component<T>(), nullptr, 0);
+    }
+
+    // Applies every command in recording order, then clears the buffer
+    SAPI void playback();
+
+    // Drops every command, giving back the handles of entities that were never created
+    SAPI void clear();
+
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    [[nodiscard]] u64 size_bytes() const { return m_size; }
+
+private:
+    struct op
+    {
+        enum type : u8
+        {
+            create,
+            destroy,
+            add,
+            remove,
+        };
+    };
+
+    struct header
+    {
+        op::type     type;
+        component_id component;
+        entity       target;
+        u32          payload_size;
+    };
+
+    SAPI void push(op::type type, entity e, component_id id, const void* payload, u32 size);
+
+    world* m_world{};
+    u8*    m_data{};
+    u64    m_size{};
+    u64    m_capacity{};
+};
+} // namespace sky::ecs
\ No newline at end of file
@@ -0,0 +1,142 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Entity.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+#include "Skyborn/Util/Util.h"
+
+#include <bit>
+#include <type_traits>
+#include <typeinfo>
+
+namespace sky::ecs
+{
+constexpr u32 max_components = 256;
+
+using component_id = u32;
+
+// Stable handle. The generation changes whenever the index is recycled, so stale handles are detected
+struct entity
+{
+    u32 index{ u32_invalid };
+    u32 generation{};
+
+    [[nodiscard]] constexpr bool is_valid() const { return index != u32_invalid; }
+
+    constexpr bool operator==(const entity& o) const = default;
+};
+
+constexpr entity null_entity{};
+
+struct component_mask
+{
+    u64 bits[max_components / 64]{};
+
+    constexpr void set(component_id id) { bits[id >> 6] |= 1ull << (id & 63); }
+
+    constexpr void clear(component_id id) { bits[id >> 6] &= ~(1ull << (id & 63)); }
+
+    [[nodiscard]] constexpr bool test(component_id id) const { return (bits[id >> 6] & (1ull << (id & 63))) != 0; }
+
+    // True if every bit set in o is also set here
+    [[nodiscard]] constexpr bool contains(const component_mask& o) const
+    {
+        for (u32 i = 0; i < max_components / 64; ++i)
+        {
+            if ((bits[i] & o.bits[i]) != o.bits[i])
+                return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool intersects(const component_mask& o) const
+    {
+        for (u32 i = 0; i < max_components / 64; ++i)
+        {
+            if (bits[i] & o.bits[i])
+                return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] constexpr u32 count() const
+    {
+        u32 total = 0;
+        for (const u64 word : bits)
+            total += (u32) std::popcount(word);
+        return total;
+    }
+
+    constexpr component_mask operator|(const component_mask& o) const
+    {
+        component_mask result{};
+        for (u32 i = 0; i < max_components / 64; ++i)
+            result.bits[i] = bits[i] | o.bits[i];
+        return result;
+    }
+
+    constexpr bool operator==(const component_mask& o) const = default;
+};
+
+struct component_info
+{
+    const char* name{};
+    u32         size{}; // 0 for tags, which take no storage
+    u32         alignment{};
+    const void* tag{}; // utl::type_tag of the type, telling apart types in anonymous namespaces that share a name
+};
+
+// Components are moved around with memcpy, so they must be trivially copyable
+template<typename T>
+concept component_type = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+/**
+ * Registers a component type. Registering the same type twice returns the existing id. Types are the same if their
+ * names are, unless they're in anonymous namespaces, in which case their tags must match too
+ * @param info Name, size and alignment of the component
+ * @return The component's id, or u32_invalid if max_components has been reached
+ */
+SAPI component_id register_component(const component_info& info);
+
+SAPI const component_info& get_component_info(component_id id);
+
+// The id of a component type. Ids agree across the DLL boundary, see utl::type_key
+template<component_type T>
+component_id component()
+{
+    static const component_id id{ register_component(
+        { typeid(T).name(), std::is_empty_v<T> ? 0u : (u32) sizeof(T), (u32) alignof(T), &utl::type_tag<T> }) };
+    return id;
+}
+
+template<component_type... C>
+component_mask mask_of()
+{
+    component_mask mask{};
+    (mask.set(component<C>()), ...);
+    return mask;
+}
+
+} // namespace sky::ecs
\ No newline at end of file
@@ -0,0 +1,254 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Scheduler.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "Scheduler.h"
+
+#include "Skyborn/Core/Thread.h"
+#include "Skyborn/Debug/Logger.h"
+#include "Skyborn/Util/Maths.h"
+
+#include <string>
+
+namespace sky::ecs
+{
+namespace
+{
+bool conflicts(const system_access& a, const system_access& b)
+{
+    return a.writes.intersects(b.reads | b.writes) || b.writes.intersects(a.reads);
+}
+
+// The caller works too, so one fewer than the performance cores
+u32 default_worker_count()
+{
+    const u32 cores{ threading::cores_of_kind(threading::core_kind::performance, true).count() };
+    return cores > 1 ? cores - 1 : 0;
+}
+
+} // anonymous namespace
+
+scheduler::scheduler(world& w, const scheduler_desc& desc) : m_world{ &w }, m_validate{ desc.validate_access }
+{
+    const u32 count{ desc.worker_count == u32_invalid ? default_worker_count() : desc.worker_count };
+    const threading::cpu_set affinity{ threading::cores_of_kind(threading::core_kind::performance, false) };
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        const std::string name{ "ECS Worker " + std::to_string(i) };
+        m_workers.push_back(
+            new std::thread{ threading::create_thread({ name.c_str(), affinity }, [this] { worker_loop(); }) });
+    }
+
+    LOG_INFO("ECS scheduler started with {} worker threads", count);
+}
+
+scheduler::~scheduler()
+{
+    {
+        std::lock_guard lock{ m_mutex };
+        m_quit = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread* t : m_workers)
+    {
+        t->join();
+        SKY_DELETE(t);
+    }
+
+    for (system* sys : m_systems)
+    {
+        SKY_DELETE(sys);
+    }
+}
+
+u32 scheduler::add_system(const system_desc& desc)
+{
+    assert_msg(desc.run, "System has nothing to run");
+    assert_msg(!desc.reads.intersects(desc.exclude) && !desc.writes.intersects(desc.exclude),
+               "System excludes a component it accesses");
+
+    auto* sys         = new system{};
+    sys->access       = { desc.name, desc.reads, desc.writes };
+    sys->q            = &m_world->find_query(desc.reads | desc.writes, desc.exclude);
+    sys->run          = desc.run;
+    sys->split_chunks = desc.split_chunks;
+    m_systems.push_back(sys);
+    m_dirty = true;
+    return (u32) m_systems.size() - 1;
+}
+
+void scheduler::run()
+{
+    if (m_dirty)
+        build_plan();
+
+    ++m_world->m_iterating;
+    for (u32 stage = 0; stage < m_stage_count; ++stage)
+    {
+        run_stage(stage);
+    }
+    --m_world->m_iterating;
+}
+
+u32 scheduler::stage_count()
+{
+    if (m_dirty)
+        build_plan();
+    return m_stage_count;
+}
+
+u32 scheduler::stage_of(u32 system)
+{
+    sky_assert(system < m_systems.size());
+    if (m_dirty)
+        build_plan();
+    return m_systems[system]->stage;
+}
+
+void scheduler::build_plan()
+{
+    m_stage_count = 0;
+    for (u32 i = 0; i < m_systems.size(); ++i)
+    {
+        u32 stage = 0;
+        for (u32 j = 0; j < i; ++j)
+        {
+            if (m_systems[j]->stage >= stage && conflicts(m_systems[i]->access, m_systems[j]->access))
+                stage = m_systems[j]->stage + 1;
+        }
+
+        m_systems[i]->stage = stage;
+        m_stage_count       = math::max(m_stage_count, stage + 1);
+    }
+
+    m_dirty = false;
+}
+
+void scheduler::run_stage(u32 stage)
+{
+    m_views.clear();
+    m_jobs.clear();
+
+    for (u32 i = 0; i < m_systems.size(); ++i)
+    {
+        system& sys{ *m_systems[i] };
+        if (sys.stage != stage)
+            continue;
+
+        const u32 first{ (u32) m_views.size() };
+        sys.q->collect_chunks(m_views);
+        const u32 count{ (u32) m_views.size() - first };
+        if (!count)
+            continue;
+
+        if (m_validate)
+        {
+            for (u32 v = first; v < m_views.size(); ++v)
+                m_views[v].access = &sys.access;
+        }
+
+        if (sys.split_chunks)
+        {
+            for (u32 c = 0; c < count; ++c)
+                m_jobs.push_back({ i, first + c, 1 });
+        } else
+        {
+            m_jobs.push_back({ i, first, count });
+        }
+    }
+
+    if (m_jobs.empty())
+        return;
+
+    m_next.store(0, std::memory_order_relaxed);
+    m_remaining.store((u32) m_jobs.size(), std::memory_order_relaxed);
+
+    // Not worth waking anyone for a single job
+    const bool wake{ !m_workers.empty() && m_jobs.size() > 1 };
+    if (wake)
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_open = true;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+    }
+
+    run_jobs();
+
+    while (m_remaining.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+
+    if (wake)
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_open = false;
+        }
+
+        while (m_active.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+    }
+}
+
+void scheduler::run_jobs()
+{
+    const u32 total{ (u32) m_jobs.size() };
+    for (;;)
+    {
+        const u32 index{ m_next.fetch_add(1, std::memory_order_relaxed) };
+        if (index >= total)
+            break;
+
+        const job&    j{ m_jobs[index] };
+        const system& sys{ *m_systems[j.system] };
+        for (u32 v = j.first; v < j.first + j.count; ++v)
+            sys.run(m_views[v]);
+
+        m_remaining.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void scheduler::worker_loop()
+{
+    u64 seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock lock{ m_mutex };
+            m_wake.wait(lock, [&] { return m_quit || (m_open && m_generation != seen); });
+            if (m_quit)
+                return;
+
+            seen = m_generation;
+            m_active.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        run_jobs();
+        m_active.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+} // namespace sky::ecs
\ No newline at end of file
@@ -0,0 +1,130 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: Scheduler.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "World.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace sky::ecs
+{
+// Read-only and read-write components of a system, e.g. reads = mask_of<velocity>(), writes = mask_of<position>()
+struct system_desc
+{
+    const char*    name{};
+    component_mask reads{};
+    component_mask writes{};
+    component_mask exclude{};
+
+    // Called once per matching chunk, possibly from several threads at once
+    std::function<void(const chunk_view&)> run{};
+
+    // Whether the chunks of this system may be spread over threads. If false, every chunk is run by one thread, in
+    // order, which allows the system to keep state between chunks
+    bool split_chunks{ true };
+};
+
+struct scheduler_desc
+{
+    u32  worker_count{ u32_invalid }; // Threads besides the caller. u32_invalid uses one per performance core
+    bool validate_access{};           // Reports components touched through chunk_view::get that weren't declared
+};
+
+/**
+ * Runs systems over a world, in parallel where their declared access allows it.
+ * Systems are grouped into stages. Two systems conflict if either writes a component the other reads or writes,
+ * and a system always runs in a later stage than any conflicting system registered before it, so registration
+ * order is kept wherever it matters. Within a stage the chunks of every system are spread over the workers.
+ */
+class scheduler
+{
+public:
+    SAPI explicit scheduler(world& w, const scheduler_desc& desc = {});
+    SAPI ~scheduler();
+
+    DISABLE_COPY_AND_MOVE(scheduler);
+
+    // Returns the system's index
+    SAPI u32 add_system(const system_desc& desc);
+
+    // Runs every system once. Structural changes to the world are not allowed until this returns
+    SAPI void run();
+
+    [[nodiscard]] u32 worker_count() const { return (u32) m_workers.size(); }
+
+    [[nodiscard]] u32 system_count() const { return (u32) m_systems.size(); }
+
+    [[nodiscard]] SAPI u32 stage_count();
+
+    // The stage the system runs in, recomputing the plan if systems were added
+    [[nodiscard]] SAPI u32 stage_of(u32 system);
+
+private:
+    struct system
+    {
+        system_access                          access;
+        query*                                 q;
+        std::function<void(const chunk_view&)> run;
+        bool                                   split_chunks;
+        u32                                    stage;
+    };
+
+    struct job
+    {
+        u32 system;
+        u32 first; // Into m_views
+        u32 count;
+    };
+
+    void build_plan();
+    void run_stage(u32 stage);
+    void run_jobs();
+    void worker_loop();
+
+    world*                    m_world{};
+    bool                      m_validate{};
+    bool                      m_dirty{};
+    u32                       m_stage_count{};
+    utl::vector<system*>      m_systems{}; // Stable, since std::function can't be moved with memcpy
+    utl::vector<chunk_view>   m_views{};
+    utl::vector<job>          m_jobs{};
+    utl::vector<std::thread*> m_workers{};
+
+    // Workers sleep on m_wake between stages. A stage is open from publishing until all its jobs are done, and
+    // workers only join while it's open, so none can still be looking at m_jobs once the next stage rebuilds it
+    std::mutex              m_mutex{};
+    std::condition_variable m_wake{};
+    u64                     m_generation{};
+    bool                    m_open{};
+    bool                    m_quit{};
+    std::atomic<u32>        m_next{};
+    std::atomic<u32>        m_remaining{};
+    std::atomic<u32>        m_active{};
+};
+} // namespace sky::ecs
\ No newline at end of file
@@ -0,0 +1,739 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: World.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "World.h"
+
+#include "Skyborn/Debug/Logger.h"
+#include "Skyborn/Util/Maths.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace sky::ecs
+{
+namespace
+{
+
+// Component ids are global so every world agrees on them
+struct component_registry
+{
+    component_info components[max_components]{};
+    u32            count{};
+    std::mutex     mutex{};
+} registry;
+
+std::atomic<u32> access_violations{};
+
+struct snapshot_header
+{
+    u32 record_count;
+    u32 free_count;
+    u32 archetype_count;
+    u32 alive;
+};
+
+struct snapshot_archetype
+{
+    component_mask mask;
+    u32            count;
+    u32            chunk_count;
+};
+
+constexpr u32 align_up(u32 value, u32 alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Largest row count for which every column, padded to its own cache line, still fits in a chunk. Writes each sized
+// column's offset when offsets is given
+u32 fit_rows(const u32* sizes, u32 column_count, u32* offsets)
+{
+    u32 row_size = sizeof(entity);
+    for (u32 i = 0; i < column_count; ++i)
+        row_size += sizes[i];
+
+    for (u32 capacity = chunk_size / row_size; capacity > 0; --capacity)
+    {
+        u32 offset = capacity * (u32) sizeof(entity);
+        for (u32 i = 0; i < column_count; ++i)
+        {
+            if (!sizes[i])
+                continue;
+
+            offset = align_up(offset, column_alignment);
+            if (offsets)
+                offsets[i] = offset;
+            offset += capacity * sizes[i];
+        }
+
+        if (offset <= chunk_size)
+            return capacity;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+component_id register_component(const component_info& info)
+{
+    std::lock_guard lock{ registry.mutex };
+    for (u32 i = 0; i < registry.count; ++i)
+    {
+        const component_info& existing{ registry.components[i] };
+        if (!utl::same_type({ existing.name, existing.tag }, { info.name, info.tag }))
+            continue;
+
+        assert_msg(existing.size == info.size && existing.alignment == info.alignment,
+                   "Component registered twice with a different size or alignment");
+        if (existing.size != info.size || existing.alignment != info.alignment)
+        {
+            LOG_ERROR("Component '{}' was already registered with a different size or alignment", info.name);
+            return u32_invalid;
+        }
+        return i;
+    }
+
+    if (registry.count == max_components)
+    {
+        LOG_ERROR("Too many component types. Can't register '{}'", info.name);
+        return u32_invalid;
+    }
+
+    assert_msg(info.alignment <= column_alignment, "Component alignment is larger than the column alignment");
+    registry.components[registry.count] = info;
+    LOG_TRACE("Registered component '{}' (id {}, {} bytes)", info.name, registry.count, info.size);
+    return registry.count++;
+}
+
+const component_info& get_component_info(component_id id)
+{
+    sky_assert(id < registry.count);
+    return registry.components[id];
+}
+
+void report_access_violation(const system_access& access, component_id id, bool write)
+{
+    access_violations.fetch_add(1, std::memory_order_relaxed);
+    LOG_ERROR("System '{}' {} component '{}' without declaring it", access.name ? access.name : "?",
+              write ? "writes" : "reads", get_component_info(id).name);
+}
+
+u32 access_violation_count()
+{
+    return access_violations.load(std::memory_order_relaxed);
+}
+
+void query::collect_chunks(utl::vector<chunk_view>& out) const
+{
+    for (archetype* arch : m_archetypes)
+    {
+        for (u64 i = 0; i < arch->chunk_count(); ++i)
+        {
+            out.push_back({ arch, &arch->chunk_at(i) });
+        }
+    }
+}
+
+u32 query::count() const
+{
+    u32 total = 0;
+    for (const archetype* arch : m_archetypes)
+        total += arch->entity_count();
+    return total;
+}
+
+world::world()
+{
+    m_root = find_or_create_archetype({});
+}
+
+world::~world()
+{
+    for (archetype* arch : m_archetypes)
+    {
+        for (auto& c : arch->m_chunks)
+            ::operator delete(c.data, std::align_val_t{ column_alignment });
+        SKY_DELETE(arch);
+    }
+
+    for (u8* data : m_free_chunks)
+        ::operator delete(data, std::align_val_t{ column_alignment });
+
+    for (query* q : m_queries)
+    {
+        SKY_DELETE(q);
+    }
+}
+
+entity world::create()
+{
+    return create_with({});
+}
+
+entity world::create_with(const component_mask& mask)
+{
+    assert_msg(!m_iterating, "Creating entities while iterating. Use a command buffer");
+    const u32 index{ new_index() };
+    const entity e{ index, m_records[index].generation };
+    move_entity(e, find_or_create_archetype(mask));
+    ++m_alive;
+    return e;
+}
+
+entity world::reserve()
+{
+    // Takes from the top of the free list, then from past the end of the records. Either way the index is only
+    // claimed here, and the records catch up on the next structural change
+    const i64 cursor{ m_free_cursor.fetch_sub(1, std::memory_order_relaxed) };
+    if (cursor > 0)
+    {
+        const u32 index{ m_free[cursor - 1] };
+        return { index, m_records[index].generation };
+    }
+
+    return { (u32) (m_records.size() - cursor), 0 };
+}
+
+void world::activate(entity reserved)
+{
+    assert_msg(!m_iterating, "Creating entities while iterating. Use a command buffer");
+    flush_reserved();
+    if (reserved.index >= m_records.size())
+        return;
+
+    entity_record& rec{ m_records[reserved.index] };
+    if (rec.generation != reserved.generation || rec.arch)
+        return;
+
+    move_entity(reserved, m_root);
+    ++m_alive;
+}
+
+void world::release(entity reserved)
+{
+    flush_reserved();
+    if (reserved.index >= m_records.size())
+        return;
+
+    entity_record& rec{ m_records[reserved.index] };
+    if (rec.generation != reserved.generation || rec.arch)
+        return;
+
+    ++rec.generation;
+    m_free.push_back(reserved.index);
+    m_free_cursor.store((i64) m_free.size(), std::memory_order_relaxed);
+}
+
+void world::destroy(entity e)
+{
+    assert_msg(!m_iterating, "Destroying entities while iterating. Use a command buffer");
+    if (!is_alive(e))
+        return;
+
+    flush_reserved();
+    entity_record& rec{ m_records[e.index] };
+    remove_row(*rec.arch, rec.chunk, rec.row);
+    rec.arch = nullptr;
+    ++rec.generation;
+    m_free.push_back(e.index);
+    m_free_cursor.store((i64) m_free.size(), std::memory_order_relaxed);
+    --m_alive;
+}
+
+bool world::is_alive(entity e) const
+{
+    return record_of(e) != nullptr;
+}
+
+void* world::add_component(entity e, component_id id)
+{
+    assert_msg(!m_iterating, "Adding components while iterating. Use a command buffer");
+    flush_reserved();
+    if (e.index >= m_records.size() || m_records[e.index].generation != e.generation)
+        return nullptr;
+
+    entity_record& rec{ m_records[e.index] };
+    if (!rec.arch)
+    {
+        // Adding a component to a reserved handle brings it to life
+        activate(e);
+    }
+
+    if (!rec.arch->has(id))
+    {
+        move_entity(e, archetype_with(rec.arch, id, true));
+    }
+
+    return get_component(e, id);
+}
+
+void world::remove_component(entity e, component_id id)
+{
+    assert_msg(!m_iterating, "Removing components while iterating. Use a command buffer");
+    const entity_record* rec{ record_of(e) };
+    if (!rec || !rec->arch->has(id))
+        return;
+
+    move_entity(e, archetype_with(rec->arch, id, false));
+}
+
+void* world::get_component(entity e, component_id id) const
+{
+    const entity_record* rec{ record_of(e) };
+    if (!rec)
+        return nullptr;
+
+    const archetype& arch{ *rec->arch };
+    if (!arch.has(id))
+        return nullptr;
+
+    const u32 column{ arch.m_column_of[id] };
+    if (arch.m_offsets[column] == u32_invalid)
+        return nullptr;
+
+    return arch.m_chunks[rec->chunk].data + arch.m_offsets[column] + (u64) rec->row * arch.m_sizes[column];
+}
+
+bool world::has_component(entity e, component_id id) const
+{
+    const entity_record* rec{ record_of(e) };
+    return rec && rec->arch->has(id);
+}
+
+query& world::find_query(const component_mask& include, const component_mask& exclude)
+{
+    for (query* q : m_queries)
+    {
+        if (q->m_include == include && q->m_exclude == exclude)
+            return *q;
+    }
+
+    auto* q      = new query{};
+    q->m_world   = this;
+    q->m_include = include;
+    q->m_exclude = exclude;
+    for (archetype* arch : m_archetypes)
+    {
+        if (q->matches(arch->m_mask))
+            q->m_archetypes.push_back(arch);
+    }
+
+    m_queries.push_back(q);
+    return *q;
+}
+
+u64 world::snapshot_size() const
+{
+    u64 size{ sizeof(snapshot_header) + m_records.size() * sizeof(entity_record) + m_free.size() * sizeof(u32) };
+    for (const archetype* arch : m_archetypes)
+    {
+        if (arch->m_count)
+            size += sizeof(snapshot_archetype) + arch->m_chunks.size() * chunk_size;
+    }
+    return size;
+}
+
+void world::save(u8* dst) const
+{
+    assert_msg(!m_iterating, "Saving the world while iterating");
+
+    snapshot_header header{ (u32) m_records.size(), (u32) m_free.size(), 0, m_alive };
+    auto*           records = (entity_record*) (dst + sizeof(snapshot_header));
+    auto*           free_list = (u32*) (records + m_records.size());
+    u8*             out{ (u8*) (free_list + m_free.size()) };
+
+    // Only non-empty archetypes are written, so records refer to them by their position in the save
+    utl::vector<u32> saved_index(m_archetypes.size());
+    for (const archetype* arch : m_archetypes)
+    {
+        if (!arch->m_count)
+            continue;
+
+        saved_index[arch->m_index] = header.archetype_count++;
+
+        const snapshot_archetype info{ arch->m_mask, arch->m_count, (u32) arch->m_chunks.size() };
+        memcpy(out, &info, sizeof(info));
+        out += sizeof(info);
+        for (const chunk& c : arch->m_chunks)
+        {
+            memcpy(out, c.data, chunk_size);
+            out += chunk_size;
+        }
+    }
+
+    memcpy(dst, &header, sizeof(header));
+    memcpy(records, m_records.data(), m_records.size() * sizeof(entity_record));
+    memcpy(free_list, m_free.data(), m_free.size() * sizeof(u32));
+    for (u32 i = 0; i < m_records.size(); ++i)
+    {
+        const archetype* arch{ m_records[i].arch };
+        records[i].arch = (archetype*) (uintptr_t) (arch ? saved_index[arch->m_index] : u32_invalid);
+    }
+}
+
+bool world::can_load(const u8* src, u64 size) const
+{
+    snapshot_header header{};
+    if (size < sizeof(header))
+        return false;
+    memcpy(&header, src, sizeof(header));
+
+    const u64 lists_size{ (u64) header.record_count * sizeof(entity_record) + (u64) header.free_count * sizeof(u32) };
+    if (size - sizeof(header) < lists_size)
+        return false;
+
+    // Rows per chunk of every saved archetype, so the records can be checked against them
+    utl::vector<u64> chunk_counts(header.archetype_count);
+    utl::vector<u32> counts(header.archetype_count);
+    utl::vector<u32> capacities(header.archetype_count);
+    const u8*        in{ src + sizeof(header) + lists_size };
+    const u8*        end{ src + size };
+    for (u32 i = 0; i < header.archetype_count; ++i)
+    {
+        snapshot_archetype info{};
+        if ((u64) (end - in) < sizeof(info))
+            return false;
+        memcpy(&info, in, sizeof(info));
+        in += sizeof(info);
+
+        u32 sizes[max_components];
+        u32 column_count{};
+        for (component_id id = 0; id < max_components; ++id)
+        {
+            if (!info.mask.test(id))
+                continue;
+            if (id >= registry.count)
+                return false;
+            sizes[column_count++] = registry.components[id].size;
+        }
+
+        const u32 capacity{ fit_rows(sizes, column_count, nullptr) };
+        if (!capacity || (u64) info.count > (u64) info.chunk_count * capacity ||
+            (info.chunk_count && info.count <= (u64) (info.chunk_count - 1) * capacity) ||
+            (u64) (end - in) / chunk_size < info.chunk_count)
+            return false;
+        in += (u64) info.chunk_count * chunk_size;
+
+        chunk_counts[i] = info.chunk_count;
+        counts[i]       = info.count;
+        capacities[i]   = capacity;
+    }
+
+    const u8* records{ src + sizeof(header) };
+    for (u32 i = 0; i < header.record_count; ++i)
+    {
+        entity_record rec{};
+        memcpy(&rec, records + i * sizeof(entity_record), sizeof(rec));
+        const u32 index{ (u32) (uintptr_t) rec.arch };
+        if (index == u32_invalid)
+            continue;
+        if (index >= header.archetype_count || rec.chunk >= chunk_counts[index] ||
+            (u64) rec.chunk * capacities[index] + rec.row >= counts[index] || rec.row >= capacities[index])
+            return false;
+    }
+
+    const u8* free_list{ records + (u64) header.record_count * sizeof(entity_record) };
+    for (u32 i = 0; i < header.free_count; ++i)
+    {
+        u32 index{};
+        memcpy(&index, free_list + i * sizeof(u32), sizeof(index));
+        if (index >= header.record_count)
+            return false;
+    }
+    return true;
+}
+
+bool world::load(const u8* src, u64 size)
+{
+    // Everything is checked before anything is torn down, so a failed load leaves the world as it was
+    if (!can_load(src, size))
+        return false;
+
+    load_unchecked(src, size);
+    return true;
+}
+
+void world::load_unchecked(const u8* src, u64 size)
+{
+    assert_msg(!m_iterating, "Loading the world while iterating");
+    sky_assert(size >= sizeof(snapshot_header));
+
+    snapshot_header header{};
+    memcpy(&header, src, sizeof(header));
+    const auto* records = (const entity_record*) (src + sizeof(snapshot_header));
+    const auto* free_list = (const u32*) (records + header.record_count);
+    const u8*   in{ (const u8*) (free_list + header.free_count) };
+
+    // Give every chunk back to the pool, so the load below reuses them without allocating
+    for (archetype* arch : m_archetypes)
+    {
+        for (const chunk& c : arch->m_chunks)
+            m_free_chunks.push_back(c.data);
+        arch->m_chunks.clear();
+        arch->m_count = 0;
+    }
+
+    utl::vector<archetype*> loaded(header.archetype_count);
+    for (u32 i = 0; i < header.archetype_count; ++i)
+    {
+        snapshot_archetype info{};
+        memcpy(&info, in, sizeof(info));
+        in += sizeof(info);
+
+        archetype* arch{ find_or_create_archetype(info.mask) };
+        arch->m_count = info.count;
+        for (u32 c = 0; c < info.chunk_count; ++c)
+        {
+            u8* data{ allocate_chunk() };
+            memcpy(data, in, chunk_size);
+            in += chunk_size;
+
+            const u32 remaining{ info.count - c * arch->m_capacity };
+            arch->m_chunks.push_back({ data, math::min(remaining, arch->m_capacity) });
+        }
+        loaded[i] = arch;
+    }
+
+    m_records.resize(header.record_count);
+    memcpy(m_records.data(), records, header.record_count * sizeof(entity_record));
+    for (entity_record& rec : m_records)
+    {
+        const u32 index{ (u32) (uintptr_t) rec.arch };
+        rec.arch = index == u32_invalid ? nullptr : loaded[index];
+    }
+
+    m_free.resize(header.free_count);
+    memcpy(m_free.data(), free_list, header.free_count * sizeof(u32));
+    m_free_cursor.store((i64) m_free.size(), std::memory_order_relaxed); // Outstanding reservations are dropped
+    m_alive = header.alive;
+}
+
+archetype* world::find_or_create_archetype(const component_mask& mask)
+{
+    for (archetype* arch : m_archetypes)
+    {
+        if (arch->m_mask == mask)
+            return arch;
+    }
+
+    auto* arch   = new archetype{};
+    arch->m_mask = mask;
+    memset(arch->m_column_of, 0xff, sizeof(arch->m_column_of));
+
+    for (component_id id = 0; id < max_components; ++id)
+    {
+        if (!mask.test(id))
+            continue;
+
+        arch->m_column_of[id] = (u16) arch->m_components.size();
+        arch->m_components.push_back(id);
+        arch->m_sizes.push_back(get_component_info(id).size);
+        arch->m_offsets.push_back(u32_invalid);
+    }
+
+    arch->m_capacity = fit_rows(arch->m_sizes.data(), (u32) arch->m_sizes.size(), arch->m_offsets.data());
+    assert_msg(arch->m_capacity, "Archetype doesn't fit in a chunk");
+    arch->m_index = (u32) m_archetypes.size();
+    m_archetypes.push_back(arch);
+
+    for (query* q : m_queries)
+    {
+        if (q->matches(mask))
+            q->m_archetypes.push_back(arch);
+    }
+
+    return arch;
+}
+
+archetype* world::archetype_with(archetype* from, component_id id, bool add)
+{
+    for (auto& edge : from->m_edges)
+    {
+        if (edge.id == id)
+        {
+            if (add ? edge.add : edge.remove)
+                return add ? edge.add : edge.remove;
+            break;
+        }
+    }
+
+    component_mask mask{ from->m_mask };
+    if (add)
+        mask.set(id);
+    else
+        mask.clear(id);
+
+    archetype* to = find_or_create_archetype(mask);
+
+    archetype::edge* cached = nullptr;
+    for (auto& edge : from->m_edges)
+    {
+        if (edge.id == id)
+            cached = &edge;
+    }
+    if (!cached)
+        cached = &from->m_edges.emplace_back(archetype::edge{ id, nullptr, nullptr });
+
+    (add ? cached->add : cached->remove) = to;
+    return to;
+}
+
+world::slot world::allocate_row(archetype& arch, entity e)
+{
+    if (arch.m_chunks.empty() || arch.m_chunks.back().count == arch.m_capacity)
+    {
+        arch.m_chunks.push_back({ allocate_chunk(), 0 });
+    }
+
+    chunk&    c{ arch.m_chunks.back() };
+    const u32 row{ c.count++ };
+    arch.entities(c)[row] = e;
+    ++arch.m_count;
+    return { (u32) arch.m_chunks.size() - 1, row };
+}
+
+void world::remove_row(archetype& arch, u32 chunk_index, u32 row)
+{
+    // Fill the hole with the archetype's last entity so every chunk but the last stays full
+    chunk&    last{ arch.m_chunks.back() };
+    const u32 last_row{ last.count - 1 };
+    chunk&    c{ arch.m_chunks[chunk_index] };
+
+    if (&c != &last || row != last_row)
+    {
+        for (u32 i = 0; i < arch.m_components.size(); ++i)
+        {
+            const u32 size{ arch.m_sizes[i] };
+            if (!size)
+                continue;
+
+            const u32 offset{ arch.m_offsets[i] };
+            memcpy(c.data + offset + (u64) row * size, last.data + offset + (u64) last_row * size, size);
+        }
+
+        const entity moved{ arch.entities(last)[last_row] };
+        arch.entities(c)[row]        = moved;
+        m_records[moved.index].chunk = chunk_index;
+        m_records[moved.index].row   = row;
+    }
+
+    --last.count;
+    --arch.m_count;
+    if (!last.count)
+    {
+        m_free_chunks.push_back(last.data);
+        arch.m_chunks.resize(arch.m_chunks.size() - 1);
+    }
+}
+
+void world::move_entity(entity e, archetype* to)
+{
+    entity_record& rec{ m_records[e.index] };
+    archetype*     from{ rec.arch };
+    if (from == to)
+        return;
+
+    const slot dst_slot{ allocate_row(*to, e) };
+    const u8*  src{ from ? from->m_chunks[rec.chunk].data : nullptr };
+    u8*        dst{ to->m_chunks[dst_slot.chunk].data };
+
+    for (u32 i = 0; i < to->m_components.size(); ++i)
+    {
+        const u32 size{ to->m_sizes[i] };
+        if (!size)
+            continue;
+
+        const component_id id{ to->m_components[i] };
+        u8* const          dst_ptr{ dst + to->m_offsets[i] + (u64) dst_slot.row * size };
+        if (from && from->has(id))
+        {
+            const u32 column{ from->m_column_of[id] };
+            memcpy(dst_ptr, src + from->m_offsets[column] + (u64) rec.row * size, size);
+        } else
+        {
+            memset(dst_ptr, 0, size);
+        }
+    }
+
+    if (from)
+    {
+        remove_row(*from, rec.chunk, rec.row);
+    }
+
+    rec.arch  = to;
+    rec.chunk = dst_slot.chunk;
+    rec.row   = dst_slot.row;
+}
+
+u8* world::allocate_chunk()
+{
+    if (!m_free_chunks.empty())
+    {
+        u8* data{ m_free_chunks.back() };
+        m_free_chunks.resize(m_free_chunks.size() - 1);
+        return data;
+    }
+
+    return (u8*) ::operator new(chunk_size, std::align_val_t{ column_alignment });
+}
+
+u32 world::new_index()
+{
+    flush_reserved();
+    if (!m_free.empty())
+    {
+        const u32 index{ m_free.back() };
+        m_free.resize(m_free.size() - 1);
+        m_free_cursor.store((i64) m_free.size(), std::memory_order_relaxed);
+        return index;
+    }
+
+    m_records.push_back({});
+    return (u32) m_records.size() - 1;
+}
+
+void world::flush_reserved()
+{
+    // Reserved indices leave the free list, and ones past the end get records that aren't alive yet
+    const i64 cursor{ m_free_cursor.load(std::memory_order_relaxed) };
+    if (cursor == (i64) m_free.size())
+        return;
+
+    if (cursor < 0)
+        m_records.resize(m_records.size() - cursor);
+    m_free.resize(cursor > 0 ? (u64) cursor : 0);
+    m_free_cursor.store((i64) m_free.size(), std::memory_order_relaxed);
+}
+
+const world::entity_record* world::record_of(entity e) const
+{
+    if (e.index >= m_records.size())
+        return nullptr;
+
+    const entity_record& rec{ m_records[e.index] };
+    return rec.generation == e.generation && rec.arch ? &rec : nullptr;
+}
+
+} // namespace sky::ecs
\ No newline at end of file
@@ -0,0 +1,396 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: World.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Entity.h"
+
+#include "Skyborn/Debug/Asserts.h"
+#include "Skyborn/Util/Vector.h"
+
+#include <atomic>
+#include <type_traits>
+
+namespace sky::ecs
+{
+// Each archetype stores its entities in fixed size chunks. A chunk holds one array per component (SoA),
+// so iterating a component is a linear walk through memory
+constexpr u32 chunk_size       = 16_KB;
+constexpr u32 column_alignment = 64; // Every column starts on its own cache line
+
+class world;
+class query;
+
+struct chunk
+{
+    u8* data{};
+    u32 count{};
+};
+
+class archetype
+{
+public:
+    [[nodiscard]] const component_mask& mask() const { return m_mask; }
+
+    [[nodiscard]] const utl::vector<component_id>& components() const { return m_components; }
+
+    // Rows per chunk
+    [[nodiscard]] u32 capacity() const { return m_capacity; }
+
+    [[nodiscard]] u32 entity_count() const { return m_count; }
+
+    [[nodiscard]] u64 chunk_count() const { return m_chunks.size(); }
+
+    [[nodiscard]] chunk& chunk_at(u64 index) { return m_chunks[index]; }
+
+    [[nodiscard]] const chunk& chunk_at(u64 index) const { return m_chunks[index]; }
+
+    [[nodiscard]] bool has(component_id id) const { return m_mask.test(id); }
+
+    [[nodiscard]] entity* entities(const chunk& c) const { return (entity*) c.data; }
+
+    // The component's array within the chunk, or nullptr if the archetype lacks it or it is a tag
+    [[nodiscard]] void* column(const chunk& c, component_id id) const
+    {
+        if (!m_mask.test(id))
+            return nullptr;
+        const u32 offset{ m_offsets[m_column_of[id]] };
+        return offset == u32_invalid ? nullptr : c.data + offset;
+    }
+
+    template<component_type T>
+    [[nodiscard]] T* column(const chunk& c) const
+    {
+        return (T*) column(c, component<T>());
+    }
+
+private:
+    friend class world;
+
+    struct edge
+    {
+        component_id id;
+        archetype*   add;
+        archetype*   remove;
+    };
+
+    component_mask            m_mask{};
+    utl::vector<component_id> m_components{}; // Ascending
+    utl::vector<u32>          m_offsets{};    // Column offset within a chunk, parallel to m_components
+    utl::vector<u32>          m_sizes{};
+    u16                       m_column_of[max_components]{};
+    u32                       m_index{}; // Position in the world's archetype list
+    u32                       m_capacity{};
+    u32                       m_count{};
+    utl::vector<chunk>        m_chunks{}; // All full except the last
+    utl::vector<edge>         m_edges{};  // Cached add/remove transitions
+};
+
+// Components a system declared it reads and writes. Set on chunk views by a scheduler that validates access
+struct system_access
+{
+    const char*    name{};
+    component_mask reads{};
+    component_mask writes{};
+};
+
+SAPI void report_access_violation(const system_access& access, component_id id, bool write);
+
+// Number of undeclared accesses caught so far
+[[nodiscard]] SAPI u32 access_violation_count();
+
+struct chunk_view
+{
+    archetype*           arch{};
+    chunk*               data{};
+    const system_access* access{};
+
+    [[nodiscard]] u32 count() const { return data->count; }
+
+    [[nodiscard]] const entity* entities() const { return arch->entities(*data); }
+
+    // get<const T>() only needs read access, get<T>() needs write access
+    template<typename T>
+        requires component_type<std::remove_const_t<T>>
+    [[nodiscard]] T* get() const
+    {
+        using U = std::remove_const_t<T>;
+        if (access)
+        {
+            check_access(component<U>(), !std::is_const_v<T>);
+        }
+        return arch->column<U>(*data);
+    }
+
+private:
+    void check_access(component_id id, bool write) const
+    {
+        if (!access->writes.test(id) && (write || !access->reads.test(id)))
+            report_access_violation(*access, id, write);
+    }
+};
+
+// Cached set of archetypes matching an include/exclude mask. Owned by the world, which keeps it up to date as
+// new archetypes appear, so iterating never has to search
+class query
+{
+public:
+    /**
+     * Calls func for every matching entity. func takes (C&...) or (entity, C&...)
+     * Tags can be part of the query's mask but not of C, since they have no storage
+     */
+    template<component_type... C, typename F>
+    void each(F&& func);
+
+    // Calls func(const chunk_view&) for every non-empty chunk
+    template<typename F>
+    void each_chunk(F&& func);
+
+    // Appends every non-empty chunk, e.g. to split the work across threads
+    SAPI void collect_chunks(utl::vector<chunk_view>& out) const;
+
+    [[nodiscard]] SAPI u32 count() const;
+
+    [[nodiscard]] const component_mask& include() const { return m_include; }
+
+    [[nodiscard]] const component_mask& exclude() const { return m_exclude; }
+
+    [[nodiscard]] const utl::vector<archetype*>& archetypes() const { return m_archetypes; }
+
+    [[nodiscard]] bool matches(const component_mask& mask) const
+    {
+        return mask.contains(m_include) && !mask.intersects(m_exclude);
+    }
+
+private:
+    friend class world;
+
+    world*                  m_world{};
+    component_mask          m_include{};
+    component_mask          m_exclude{};
+    utl::vector<archetype*> m_archetypes{};
+};
+
+class world
+{
+public:
+    SAPI world();
+    SAPI ~world();
+
+    DISABLE_COPY_AND_MOVE(world);
+
+    SAPI entity create();
+
+    template<component_type... C>
+    entity create(const C&... components)
+    {
+        const entity e{ create_with(mask_of<C...>()) };
+        (set(e, components), ...);
+        return e;
+    }
+
+    SAPI void destroy(entity e);
+
+    [[nodiscard]] SAPI bool is_alive(entity e) const;
+
+    [[nodiscard]] u32 entity_count() const { return m_alive; }
+
+    // Hands out a handle that only becomes alive once activated, e.g. by a command buffer's playback. Safe to call
+    // from several threads at once, as long as nothing changes the world's structure meanwhile
+    SAPI entity reserve();
+    SAPI void   activate(entity reserved);
+
+    // Gives back a reserved handle that was never activated
+    SAPI void release(entity reserved);
+
+    template<component_type T>
+    void add(entity e, const T& value = {})
+    {
+        void* data{ add_component(e, component<T>()) };
+        if constexpr (!std::is_empty_v<T>)
+        {
+            if (data)
+                memcpy(data, &value, sizeof(T));
+        }
+    }
+
+    // Adds the component if missing
+    template<component_type T>
+    void set(entity e, const T& value)
+    {
+        add(e, value);
+    }
+
+    template<component_type T>
+    void remove(entity e)
+    {
+        remove_component(e, component<T>());
+    }
+
+    template<component_type T>
+    [[nodiscard]] bool has(entity e) const
+    {
+        return has_component(e, component<T>());
+    }
+
+    template<component_type T>
+    [[nodiscard]] T* get(entity e) const
+    {
+        return (T*) get_component(e, component<T>());
+    }
+
+    // Type-erased versions of the above. add_component returns the (zeroed if new) storage, nullptr for tags
+    SAPI void* add_component(entity e, component_id id);
+    SAPI void  remove_component(entity e, component_id id);
+
+    [[nodiscard]] SAPI void* get_component(entity e, component_id id) const;
+    [[nodiscard]] SAPI bool  has_component(entity e, component_id id) const;
+
+    // Returns the cached query for the given masks, creating it on first use
+    SAPI query& find_query(const component_mask& include, const component_mask& exclude = {});
+
+    template<component_type... C>
+    query& query_of()
+    {
+        static_assert(sizeof...(C) > 0);
+        return find_query(mask_of<C...>());
+    }
+
+    template<component_type... C, typename F>
+    void each(F&& func)
+    {
+        query_of<C...>().template each<C...>(std::forward<F>(func));
+    }
+
+    [[nodiscard]] const utl::vector<archetype*>& archetypes() const { return m_archetypes; }
+
+    // Bytes needed to save the world's entities and components
+    [[nodiscard]] SAPI u64 snapshot_size() const;
+
+    // Writes every entity and component into dst, which must hold snapshot_size() bytes. Chunks are copied whole
+    SAPI void save(u8* dst) const;
+
+    // Checks that a save is whole and consistent with the registered components, without touching the world
+    [[nodiscard]] SAPI bool can_load(const u8* src, u64 size) const;
+
+    // Replaces the world's contents with a save. Archetypes and cached queries stay valid. Returns false, with the
+    // world unchanged, if can_load does
+    SAPI bool load(const u8* src, u64 size);
+
+    // load without the checks, for a save can_load has already accepted
+    SAPI void load_unchecked(const u8* src, u64 size);
+
+private:
+    friend class query;
+    friend class scheduler;
+
+    struct entity_record
+    {
+        archetype* arch; // nullptr while free or reserved
+        u32        chunk;
+        u32        row;
+        u32        generation;
+    };
+
+    struct slot
+    {
+        u32 chunk;
+        u32 row;
+    };
+
+    SAPI entity create_with(const component_mask& mask);
+
+    archetype* find_or_create_archetype(const component_mask& mask);
+    archetype* archetype_with(archetype* from, component_id id, bool add);
+    slot       allocate_row(archetype& arch, entity e);
+    void       remove_row(archetype& arch, u32 chunk_index, u32 row);
+    void       move_entity(entity e, archetype* to);
+    u8*        allocate_chunk();
+    u32        new_index();
+    void       flush_reserved();
+
+    const entity_record* record_of(entity e) const;
+
+    utl::vector<entity_record> m_records{};
+    utl::vector<u32>           m_free{};
+    std::atomic<i64>           m_free_cursor{}; // m_free.size() minus reservations; below zero, past m_records
+    utl::vector<archetype*>    m_archetypes{};
+    utl::vector<query*>        m_queries{};
+    utl::vector<u8*>           m_free_chunks{};
+    archetype*                 m_root{};
+    u32                        m_alive{};
+    u32                        m_iterating{}; // Structural changes are not allowed while a query is iterating
+};
+
+namespace detail
+{
+template<typename F, typename... C>
+void for_rows(F& func, u32 count, const entity* entities, C*... columns)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        if constexpr (std::is_invocable_v<F&, entity, C&...>)
+        {
+            func(entities[i], columns[i]...);
+        } else
+        {
+            func(columns[i]...);
+        }
+    }
+}
+} // namespace detail
+
+template<component_type... C, typename F>
+void query::each(F&& func)
+{
+    static_assert((!std::is_empty_v<C> && ...), "Tags have no storage to iterate");
+    assert_dbg(m_include.contains(mask_of<C...>()));
+
+    ++m_world->m_iterating;
+    for (archetype* arch : m_archetypes)
+    {
+        for (u64 i = 0; i < arch->chunk_count(); ++i)
+        {
+            const chunk& c{ arch->chunk_at(i) };
+            detail::for_rows(func, c.count, arch->entities(c), arch->template column<C>(c)...);
+        }
+    }
+    --m_world->m_iterating;
+}
+
+template<typename F>
+void query::each_chunk(F&& func)
+{
+    ++m_world->m_iterating;
+    for (archetype* arch : m_archetypes)
+    {
+        for (u64 i = 0; i < arch->chunk_count(); ++i)
+        {
+            func(chunk_view{ arch, &arch->chunk_at(i) });
+        }
+    }
+    --m_world->m_iterating;
+}
+
+} // namespace sky::ecs
\ No newline at end of file
@@ -21,10 +21,14 @@
 // Author: Matt
 //
 // ------------------------------------------------------------------------------
+#define SKY_LOG_CATEGORY renderer
+
 #include "Renderer.h"
 
 #include "GraphicsPlatformInterface.h"
-#include "Vulkan/VkInterface.h"
+#ifndef SKY_HEADLESS
+    #include "Vulkan/VkInterface.h"
+#endif
 
 #include "Skyborn/Debug/Logger.h"
 #include "Skyborn/Debug/Asserts.h"
@@ -35,11 +39,48 @@ namespace
 {
 platform_interface gfx{};
 
+namespace null_backend
+{
+bool initialize(const char* app_name)
+{
+    LOG_INFO("Rendering disabled. Using the null graphics backend");
+    return true;
+}
+
+void shutdown() {}
+
+void resized(u16 width, u16 height) {}
+
+bool begin_frame(f32 delta)
+{
+    return true;
+}
+
+bool end_frame(f32 delta)
+{
+    return true;
+}
+
+void get_platform_interface(platform_interface& plat_interface)
+{
+    plat_interface.initialize  = initialize;
+    plat_interface.shutdown    = shutdown;
+    plat_interface.resized     = resized;
+    plat_interface.begin_frame = begin_frame;
+    plat_interface.end_frame   = end_frame;
+
+    plat_interface.platform = backend_api::none;
+}
+} // namespace null_backend
+
 bool set_platform_interface(backend_api api, platform_interface& plat_interface)
 {
     switch (api)
     {
+#ifndef SKY_HEADLESS
     case backend_api::vulkan: vk::get_platform_interface(plat_interface); break;
+#endif
+    case backend_api::none: null_backend::get_platform_interface(plat_interface); break;
     default: return false;
     }
 
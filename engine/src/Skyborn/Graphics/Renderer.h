@@ -32,9 +32,16 @@ enum struct backend_api : u32
 {
     vulkan,
     opengl,
-    directx
+    directx,
+    none, // Headless. Frames are "drawn" without touching a GPU
 };
 
+#ifdef SKY_HEADLESS
+constexpr backend_api default_backend = backend_api::none;
+#else
+constexpr backend_api default_backend = backend_api::vulkan;
+#endif
+
 struct render_packet
 {
     f32 delta{};
@@ -22,6 +22,8 @@
 //
 // ------------------------------------------------------------------------------
 
+#define SKY_LOG_CATEGORY vulkan
+
 #include "VkCommandBuffer.h"
 #include "VkCore.h"
 #include "VkFence.h"
@@ -21,6 +21,8 @@
 // Author: Matt
 //
 // ------------------------------------------------------------------------------
+#define SKY_LOG_CATEGORY vulkan
+
 #include "VkCore.h"
 
 #include "Skyborn/Util/Util.h"
@@ -282,13 +284,17 @@ VKAPI_ATTR VkBool32 VKAPI_CALL debug_callback(VkDebugUtilsMessageSeverityFlagBit
 {
     switch (message_severity)
     {
-    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT: LOG_ERROR("Vulkan Error: {}", callback_data->pMessage); break;
+    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
+        LOG_CAT(validation, error, "Vulkan Error: {}", callback_data->pMessage);
+        break;
     case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-        LOG_WARN("Vulkan Warning: {}", callback_data->pMessage);
+        LOG_CAT(validation, warn, "Vulkan Warning: {}", callback_data->pMessage);
+        break;
+    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
+        LOG_CAT(validation, info, "Vulkan Info: {}", callback_data->pMessage);
         break;
-    case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT: LOG_INFO("Vulkan Info: {}", callback_data->pMessage); break;
     case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
-        LOG_TRACE("Vulkan Verbose Info: {}", callback_data->pMessage);
+        LOG_CAT(validation, trace, "Vulkan Verbose Info: {}", callback_data->pMessage);
         break;
     default: break;
     }
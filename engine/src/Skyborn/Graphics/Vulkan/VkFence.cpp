@@ -21,6 +21,8 @@
 // Author: Matt
 //
 // ------------------------------------------------------------------------------
+#define SKY_LOG_CATEGORY vulkan
+
 #include "VkFence.h"
 #include "VkCore.h"
 
@@ -22,6 +22,8 @@
 //
 // ------------------------------------------------------------------------------
 
+#define SKY_LOG_CATEGORY vulkan
+
 #include "VkHelpers.h"
 
 namespace sky::graphics::vk
@@ -22,6 +22,8 @@
 //
 // ------------------------------------------------------------------------------
 
+#define SKY_LOG_CATEGORY vulkan
+
 #include "VkInterface.h"
 
 #include "VkCore.h"
@@ -21,6 +21,8 @@
 // Author: Matt
 //
 // ------------------------------------------------------------------------------
+#define SKY_LOG_CATEGORY vulkan
+
 #include "VkRenderpass.h"
 #include "VkCore.h"
 
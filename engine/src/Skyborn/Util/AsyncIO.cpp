@@ -0,0 +1,656 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: AsyncIO.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "AsyncIO.h"
+
+#include "FileSystem.h"
+#include "Vector.h"
+#include "Skyborn/Core/Thread.h"
+#include "Skyborn/Debug/Logger.h"
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef SKY_PLATFORM_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef SKY_PLATFORM_LINUX
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace sky::utl::aio
+{
+namespace
+{
+struct slot_state
+{
+    enum state : u8
+    {
+        free,
+        queued, // Submitted, not finished
+        done,   // Finished, callback not yet run
+    };
+};
+
+struct request_slot
+{
+    io_request        request;
+    i64               result; // With io_uring, the bytes moved so far until the request is done
+    u32               generation;
+    slot_state::state state;
+};
+
+// How many finished requests poll takes at a time. It goes around again for more
+constexpr u32 poll_batch = 64;
+
+struct aio_state
+{
+    request_slot*    slots{};
+    u32              capacity{};
+    utl::vector<u32> free_slots{};
+    u32              in_flight{};
+    bool             initialized{};
+    bool             uring{};
+
+    // Guards the slots and queues, and with io_uring the submission ring. Never held while a callback runs
+    std::mutex mutex{};
+
+    // Thread pool fallback
+    utl::vector<std::thread*> workers{};
+    u32*                      queue{}; // Ring of slots waiting for a worker
+    u32                       queue_head{};
+    u32                       queue_count{};
+    u32*                      completed{}; // Ring of slots finished by workers, waiting for poll
+    u32                       completed_head{};
+    u32                       completed_count{};
+    std::condition_variable   work{};
+    std::condition_variable   finished{};
+    bool                      quit{};
+};
+
+aio_state state{};
+
+// Reads or writes the whole request, looping over short transfers. Used by the pool
+i64 transfer(const io_request& request)
+{
+    u8* buffer{ (u8*) request.buffer };
+    u64 total = 0;
+    while (total < request.size)
+    {
+        const u64 offset{ request.offset + total };
+        const u32 remaining{ (u32) (request.size - total) };
+#ifdef SKY_PLATFORM_WINDOWS
+        OVERLAPPED position{};
+        position.Offset     = (DWORD) offset;
+        position.OffsetHigh = (DWORD) (offset >> 32);
+
+        const HANDLE handle{ (HANDLE) request.file.handle };
+        DWORD        moved{};
+        const BOOL   ok{ request.write ? WriteFile(handle, buffer + total, remaining, &moved, &position)
+                                       : ReadFile(handle, buffer + total, remaining, &moved, &position) };
+        if (!ok)
+        {
+            if (GetLastError() == ERROR_HANDLE_EOF)
+                break;
+            return -(i64) GetLastError();
+        }
+#else
+        const i32     fd{ (i32) request.file.handle };
+        const ssize_t moved{ request.write ? pwrite(fd, buffer + total, remaining, (off_t) offset)
+                                           : pread(fd, buffer + total, remaining, (off_t) offset) };
+        if (moved < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return -errno;
+        }
+#endif
+        if (moved == 0)
+            break; // End of the file
+
+        total += (u64) moved;
+    }
+    return (i64) total;
+}
+
+void worker_loop()
+{
+    std::unique_lock lock{ state.mutex };
+    for (;;)
+    {
+        state.work.wait(lock, [] { return state.quit || state.queue_count; });
+        if (!state.queue_count)
+            return;
+
+        const u32 index{ state.queue[state.queue_head] };
+        state.queue_head = (state.queue_head + 1) & (state.capacity - 1);
+        --state.queue_count;
+
+        const io_request request{ state.slots[index].request };
+        lock.unlock();
+        const i64 result{ transfer(request) };
+        lock.lock();
+
+        state.slots[index].result = result;
+        state.slots[index].state  = slot_state::done;
+        state.completed[(state.completed_head + state.completed_count) & (state.capacity - 1)] = index;
+        ++state.completed_count;
+        state.finished.notify_one();
+    }
+}
+
+#ifdef SKY_PLATFORM_LINUX
+struct uring_state
+{
+    i32            fd{ -1 };
+    u32*           sq_tail{};
+    u32*           sq_mask{};
+    u32*           sq_array{};
+    io_uring_sqe*  sqes{};
+    u32*           cq_head{};
+    u32*           cq_tail{};
+    u32*           cq_mask{};
+    io_uring_cqe*  cqes{};
+    void*          sq_ring{};
+    void*          cq_ring{};
+    u64            sq_ring_size{};
+    u64            cq_ring_size{};
+    u64            sqes_size{};
+    u32            unsubmitted{}; // Queued in the ring but not yet taken by the kernel
+};
+
+uring_state uring{};
+
+i32 uring_enter(u32 to_submit, u32 min_complete, u32 flags)
+{
+    return (i32) syscall(__NR_io_uring_enter, uring.fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+template<typename T>
+T* ring_at(void* ring, u32 offset)
+{
+    return (T*) ((u8*) ring + offset);
+}
+
+void uring_destroy()
+{
+    if (uring.sqes)
+        munmap(uring.sqes, uring.sqes_size);
+    if (uring.cq_ring && uring.cq_ring != uring.sq_ring)
+        munmap(uring.cq_ring, uring.cq_ring_size);
+    if (uring.sq_ring)
+        munmap(uring.sq_ring, uring.sq_ring_size);
+    if (uring.fd >= 0)
+        ::close(uring.fd);
+    uring = {};
+}
+
+bool uring_create(u32 entries)
+{
+    io_uring_params params{};
+    uring.fd = (i32) syscall(__NR_io_uring_setup, entries, &params);
+    if (uring.fd < 0)
+    {
+        uring.fd = -1;
+        return false;
+    }
+
+    uring.sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    uring.cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap{ (params.features & IORING_FEAT_SINGLE_MMAP) != 0 };
+    if (single_mmap)
+        uring.sq_ring_size = uring.cq_ring_size = std::max(uring.sq_ring_size, uring.cq_ring_size);
+
+    uring.sq_ring = mmap(nullptr, uring.sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+                         IORING_OFF_SQ_RING);
+    if (uring.sq_ring == MAP_FAILED)
+    {
+        uring.sq_ring = nullptr;
+        uring_destroy();
+        return false;
+    }
+
+    uring.cq_ring = single_mmap ? uring.sq_ring
+                                : mmap(nullptr, uring.cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                       uring.fd, IORING_OFF_CQ_RING);
+    uring.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes{ mmap(nullptr, uring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+                     IORING_OFF_SQES) };
+    if (uring.cq_ring == MAP_FAILED || sqes == MAP_FAILED)
+    {
+        if (uring.cq_ring == MAP_FAILED)
+            uring.cq_ring = nullptr;
+        if (sqes != MAP_FAILED)
+            munmap(sqes, uring.sqes_size);
+        uring_destroy();
+        return false;
+    }
+
+    uring.sqes     = (io_uring_sqe*) sqes;
+    uring.sq_tail  = ring_at<u32>(uring.sq_ring, params.sq_off.tail);
+    uring.sq_mask  = ring_at<u32>(uring.sq_ring, params.sq_off.ring_mask);
+    uring.sq_array = ring_at<u32>(uring.sq_ring, params.sq_off.array);
+    uring.cq_head  = ring_at<u32>(uring.cq_ring, params.cq_off.head);
+    uring.cq_tail  = ring_at<u32>(uring.cq_ring, params.cq_off.tail);
+    uring.cq_mask  = ring_at<u32>(uring.cq_ring, params.cq_off.ring_mask);
+    uring.cqes     = ring_at<io_uring_cqe>(uring.cq_ring, params.cq_off.cqes);
+    return true;
+}
+
+// Hands everything queued in the ring to the kernel. Called with the mutex held
+void uring_flush()
+{
+    while (uring.unsubmitted)
+    {
+        const i32 taken{ uring_enter(uring.unsubmitted, 0, 0) };
+        if (taken < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return; // Busy, try again on the next poll
+        }
+        uring.unsubmitted -= (u32) taken;
+    }
+}
+
+// Queues whatever part of the request hasn't been moved yet
+void uring_queue(u32 index)
+{
+    const request_slot& slot{ state.slots[index] };
+    const io_request&   request{ slot.request };
+    const u64           moved{ (u64) slot.result };
+    const u32           tail{ *uring.sq_tail };
+    const u32           at{ tail & *uring.sq_mask };
+
+    io_uring_sqe& sqe{ uring.sqes[at] };
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode    = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe.fd        = (i32) request.file.handle;
+    sqe.off       = request.offset + moved;
+    sqe.addr      = (u64) (uintptr_t) ((u8*) request.buffer + moved);
+    sqe.len       = (u32) (request.size - moved);
+    sqe.user_data = index;
+    uring.sq_array[at] = at;
+
+    // The kernel reads the entry once it sees the new tail
+    std::atomic_ref{ *uring.sq_tail }.store(tail + 1, std::memory_order_release);
+    ++uring.unsubmitted;
+}
+
+// Takes finished requests off the completion ring. Called with the mutex held
+u32 uring_reap(u32* ready, u32 max)
+{
+    u32       count = 0;
+    u32       head{ *uring.cq_head };
+    const u32 tail{ std::atomic_ref{ *uring.cq_tail }.load(std::memory_order_acquire) };
+    for (; head != tail && count < max; ++head)
+    {
+        const io_uring_cqe& cqe{ uring.cqes[head & *uring.cq_mask] };
+        const u32           index{ (u32) cqe.user_data };
+        request_slot&       slot{ state.slots[index] };
+
+        // Like the pool's transfer, short transfers go again for the rest until the end of the file
+        if (cqe.res > 0 && (u64) slot.result + (u64) cqe.res < slot.request.size)
+        {
+            slot.result += cqe.res;
+            uring_queue(index);
+            continue;
+        }
+        if (cqe.res == -EINTR)
+        {
+            uring_queue(index);
+            continue;
+        }
+
+        slot.result    = cqe.res < 0 ? cqe.res : slot.result + cqe.res;
+        slot.state     = slot_state::done;
+        ready[count++] = index;
+    }
+    std::atomic_ref{ *uring.cq_head }.store(head, std::memory_order_release);
+    return count;
+}
+#endif
+
+// Takes finished requests from whichever backend. Called with the mutex held
+u32 take_finished(u32* ready)
+{
+#ifdef SKY_PLATFORM_LINUX
+    if (state.uring)
+    {
+        uring_flush();
+        const u32 count{ uring_reap(ready, poll_batch) };
+        uring_flush(); // Whatever the reap queued again
+        return count;
+    }
+#endif
+
+    const u32 count{ std::min(state.completed_count, poll_batch) };
+    for (u32 i = 0; i < count; ++i)
+        ready[i] = state.completed[(state.completed_head + i) & (state.capacity - 1)];
+    state.completed_head = (state.completed_head + count) & (state.capacity - 1);
+    state.completed_count -= count;
+    return count;
+}
+
+// Sleeps until something finishes, or a little while has passed
+void block_for_completion()
+{
+#ifdef SKY_PLATFORM_LINUX
+    if (state.uring)
+    {
+        bool submitted;
+        {
+            std::lock_guard lock{ state.mutex };
+            uring_flush();
+            submitted = uring.unsubmitted == 0;
+        }
+
+        // Waiting on requests the kernel hasn't taken yet could block forever, so those are retried next time round
+        if (submitted)
+            uring_enter(0, 1, IORING_ENTER_GETEVENTS);
+        else
+            std::this_thread::yield();
+        return;
+    }
+#endif
+
+    std::unique_lock lock{ state.mutex };
+    state.finished.wait_for(lock, std::chrono::milliseconds{ 1 }, [] { return state.completed_count != 0; });
+}
+
+} // anonymous namespace
+
+bool initialize(const aio_desc& desc)
+{
+    if (state.initialized)
+        return false;
+
+    state.capacity = std::bit_ceil(std::max(desc.queue_depth, 2u));
+    state.slots    = new request_slot[state.capacity]{};
+    state.free_slots.clear();
+    for (u32 i = state.capacity; i > 0; --i)
+        state.free_slots.push_back(i - 1);
+    state.in_flight = 0;
+    state.quit      = false;
+    state.uring     = false;
+
+#ifdef SKY_PLATFORM_LINUX
+    state.uring = desc.use_io_uring && uring_create(state.capacity);
+#endif
+
+    if (!state.uring)
+    {
+        state.queue           = new u32[state.capacity];
+        state.completed       = new u32[state.capacity];
+        state.queue_head      = 0;
+        state.queue_count     = 0;
+        state.completed_head  = 0;
+        state.completed_count = 0;
+
+        // Workers spend their time blocked on the disk, so they don't need the fast cores
+        const threading::cpu_set affinity{ threading::cores_of_kind(threading::core_kind::efficiency, false) };
+        for (u32 i = 0; i < std::max(desc.worker_count, 1u); ++i)
+        {
+            std::thread worker{ threading::create_thread({ "IO Worker", affinity }, worker_loop) };
+            state.workers.push_back(new std::thread{ std::move(worker) });
+        }
+    }
+
+    state.initialized = true;
+    LOG_INFO("Async IO submodule initialized ({}, {} requests deep)", state.uring ? "io_uring" : "thread pool",
+             state.capacity);
+    return true;
+}
+
+void shutdown()
+{
+    if (!state.initialized)
+        return;
+
+    wait_all();
+
+    {
+        std::lock_guard lock{ state.mutex };
+        state.quit = true;
+    }
+    state.work.notify_all();
+    for (std::thread* worker : state.workers)
+    {
+        worker->join();
+        delete worker;
+    }
+    state.workers.clear();
+
+#ifdef SKY_PLATFORM_LINUX
+    if (state.uring)
+        uring_destroy();
+#endif
+
+    delete[] state.queue;
+    delete[] state.completed;
+    delete[] state.slots;
+    state.queue       = nullptr;
+    state.completed   = nullptr;
+    state.slots       = nullptr;
+    state.initialized = false;
+    LOG_INFO("Async IO submodule shutdown");
+}
+
+bool using_io_uring()
+{
+    return state.uring;
+}
+
+bool open(const char* path, u8 mode, io_file& file)
+{
+    file = {};
+    const bool reading{ (mode & fs::file_modes::read) != 0 };
+    const bool writing{ (mode & fs::file_modes::write) != 0 };
+    if ((mode & fs::file_modes::append) || (!reading && !writing))
+    {
+        LOG_ERROR("Invalid async file mode for '{}'", path);
+        return false;
+    }
+
+#ifdef SKY_PLATFORM_WINDOWS
+    const DWORD access{ (reading ? GENERIC_READ : 0u) | (writing ? GENERIC_WRITE : 0u) };
+    const DWORD creation{ !writing ? OPEN_EXISTING : reading ? OPEN_ALWAYS : CREATE_ALWAYS };
+    const HANDLE handle{
+        CreateFileA(path, access, FILE_SHARE_READ, nullptr, creation, FILE_ATTRIBUTE_NORMAL, nullptr)
+    };
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("Error while opening file '{}'", path);
+        return false;
+    }
+    file.handle = (intptr_t) handle;
+#else
+    const i32 flags{ !writing ? O_RDONLY : reading ? O_RDWR | O_CREAT : O_WRONLY | O_CREAT | O_TRUNC };
+    const i32 fd{ ::open(path, flags | O_CLOEXEC, 0644) };
+    if (fd < 0)
+    {
+        LOG_ERROR("Error while opening file '{}'", path);
+        return false;
+    }
+    file.handle = fd;
+#endif
+    return true;
+}
+
+void close(io_file& file)
+{
+    if (!file.is_valid())
+        return;
+
+#ifdef SKY_PLATFORM_WINDOWS
+    CloseHandle((HANDLE) file.handle);
+#else
+    ::close((i32) file.handle);
+#endif
+    file = {};
+}
+
+u64 file_size(io_file file)
+{
+#ifdef SKY_PLATFORM_WINDOWS
+    LARGE_INTEGER size{};
+    return GetFileSizeEx((HANDLE) file.handle, &size) ? (u64) size.QuadPart : 0;
+#else
+    struct stat info
+    {};
+    return fstat((i32) file.handle, &info) == 0 ? (u64) info.st_size : 0;
+#endif
+}
+
+u32 submit(const io_request* requests, u32 count, io_ticket* tickets)
+{
+    if (!state.initialized)
+    {
+        LOG_ERROR("Async IO must be initialized before submitting");
+        return 0;
+    }
+
+    u32 accepted = 0;
+    {
+        std::lock_guard lock{ state.mutex };
+        for (; accepted < count && !state.free_slots.empty(); ++accepted)
+        {
+            const u32 index{ state.free_slots.back() };
+            state.free_slots.erase_unordered(state.free_slots.size() - 1);
+
+            request_slot& slot{ state.slots[index] };
+            slot.request = requests[accepted];
+            slot.result  = 0;
+            slot.state   = slot_state::queued;
+            ++state.in_flight;
+            if (tickets)
+                tickets[accepted] = { index, slot.generation };
+
+#ifdef SKY_PLATFORM_LINUX
+            if (state.uring)
+            {
+                uring_queue(index);
+                continue;
+            }
+#endif
+            state.queue[(state.queue_head + state.queue_count) & (state.capacity - 1)] = index;
+            ++state.queue_count;
+        }
+
+#ifdef SKY_PLATFORM_LINUX
+        // The whole batch goes to the kernel in one syscall
+        if (state.uring)
+            uring_flush();
+#endif
+    }
+
+    if (!state.uring && accepted)
+        state.work.notify_all();
+
+    for (u32 i = accepted; i < count && tickets; ++i)
+        tickets[i] = invalid_ticket;
+    return accepted;
+}
+
+u32 poll()
+{
+    if (!state.initialized)
+        return 0;
+
+    u32 total = 0;
+    for (;;)
+    {
+        u32 ready[poll_batch];
+        u32 count;
+        {
+            std::lock_guard lock{ state.mutex };
+            count = take_finished(ready);
+        }
+        if (!count)
+            return total;
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            const request_slot& slot{ state.slots[ready[i]] };
+            if (slot.request.on_complete)
+                slot.request.on_complete(slot.request, slot.result);
+
+            std::lock_guard lock{ state.mutex };
+            state.slots[ready[i]].state = slot_state::free;
+            ++state.slots[ready[i]].generation;
+            state.free_slots.push_back(ready[i]);
+            --state.in_flight;
+        }
+        total += count;
+    }
+}
+
+void wait(io_ticket ticket)
+{
+    while (!is_done(ticket))
+    {
+        if (!poll())
+            block_for_completion();
+    }
+}
+
+void wait_all()
+{
+    while (in_flight())
+    {
+        if (!poll())
+            block_for_completion();
+    }
+}
+
+bool is_done(io_ticket ticket)
+{
+    if (!state.initialized || ticket.index >= state.capacity)
+        return true;
+
+    std::lock_guard lock{ state.mutex };
+    return state.slots[ticket.index].generation != ticket.generation;
+}
+
+u32 in_flight()
+{
+    std::lock_guard lock{ state.mutex };
+    return state.in_flight;
+}
+} // namespace sky::utl::aio
\ No newline at end of file
@@ -0,0 +1,128 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: AsyncIO.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+
+// Asynchronous reads and writes at explicit offsets, into buffers the caller owns. Linux submits them to io_uring,
+// other platforms, or kernels without it, hand them to a small pool of worker threads. Requests can be submitted
+// from any thread. Completion callbacks run on the thread that calls poll or wait, which should only ever be one at a
+// time; app::run polls once a frame
+namespace sky::utl::aio
+{
+// Native file opened for positional I/O, which stdio can't do
+struct io_file
+{
+    intptr_t handle{ -1 };
+
+    [[nodiscard]] constexpr bool is_valid() const { return handle != -1; }
+};
+
+// Stable handle to a submitted request. The generation changes once its callback has run
+struct io_ticket
+{
+    u32 index{ u32_invalid };
+    u32 generation{};
+
+    [[nodiscard]] constexpr bool is_valid() const { return index != u32_invalid; }
+};
+
+constexpr io_ticket invalid_ticket{};
+
+struct io_request;
+
+/**
+ * Called once a request finishes
+ * @param request The request as submitted
+ * @param result Bytes transferred, fewer than asked for at the end of the file, or negative on error
+ */
+using func_on_complete = void (*)(const io_request& request, i64 result);
+
+struct io_request
+{
+    io_file          file{};
+    u64              offset{};
+    void*            buffer{}; // Must stay valid until the callback has run
+    u32              size{};
+    bool             write{};
+    func_on_complete on_complete{};
+    void*            user_data{};
+};
+
+struct aio_desc
+{
+    u32  queue_depth{ 256 }; // Requests in flight at once. Rounded up to a power of two
+    u32  worker_count{ 2 };  // Threads of the fallback pool
+    bool use_io_uring{ true };
+};
+
+SAPI bool initialize(const aio_desc& desc = {});
+
+// Waits for everything in flight, running its callbacks
+SAPI void shutdown();
+
+// True if requests go through io_uring rather than the thread pool
+[[nodiscard]] SAPI bool using_io_uring();
+
+/**
+ * Opens a file for aio requests
+ * @param path The file
+ * @param mode utl::fs::file_modes. Write creates or empties the file, read and write opens it without emptying it,
+ * creating it if needed. Append isn't supported, since every request has its own offset
+ * @param file Receives the file
+ * @return true if the file was opened, false otherwise
+ */
+SAPI bool open(const char* path, u8 mode, io_file& file);
+SAPI void close(io_file& file);
+[[nodiscard]] SAPI u64 file_size(io_file file);
+
+/**
+ * Queues a batch of requests with a single submission
+ * @param requests The requests. Copied, so the array needn't outlive the call
+ * @param count How many
+ * @param tickets Optional, receives a ticket per accepted request
+ * @return How many were accepted. Fewer than count when the queue is full; poll to make room
+ */
+SAPI u32 submit(const io_request* requests, u32 count, io_ticket* tickets = nullptr);
+
+inline io_ticket submit(const io_request& request)
+{
+    io_ticket ticket{};
+    submit(&request, 1, &ticket);
+    return ticket;
+}
+
+// Runs the callbacks of every finished request without blocking. Returns how many ran
+SAPI u32 poll();
+
+// Blocks until the request's callback has run, running other callbacks on the way
+SAPI void wait(io_ticket ticket);
+
+// Blocks until nothing is in flight
+SAPI void wait_all();
+
+[[nodiscard]] SAPI bool is_done(io_ticket ticket);
+[[nodiscard]] SAPI u32  in_flight();
+} // namespace sky::utl::aio
\ No newline at end of file
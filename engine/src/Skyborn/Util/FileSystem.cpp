@@ -24,8 +24,10 @@
 
 #include "FileSystem.h"
 
+#include "Skyborn/Core/Platform.h"
 #include "Skyborn/Debug/Logger.h"
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <sys/stat.h>
 
@@ -114,7 +116,9 @@ bool read_line_trim(const file_handle& handle, std::string& line)
     if (!read_line(handle, line))
         return false;
 
-    std::erase(line, '\n');
+    // fgets stops at the newline, so it can only be at the end
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+        line.pop_back();
     return true;
 }
 
@@ -172,4 +176,113 @@ bool write(const file_handle& handle, u64 size, const void* data, u64& written)
     fflush((FILE*) handle.handle);
     return true;
 }
+bool open(const char* path, line_reader& reader, u64 buffer_size)
+{
+    reader = {};
+    if (!open(path, file_modes::read, true, reader.file))
+        return false;
+
+    // Reads are already as large as stdio's buffer would be, so copying through it is only overhead
+    setvbuf((FILE*) reader.file.handle, nullptr, _IONBF, 0);
+
+    reader.capacity = buffer_size < 16 ? 16 : buffer_size;
+    reader.buffer   = (char*) malloc(reader.capacity);
+    if (!reader.buffer)
+    {
+        LOG_ERROR("Failed to allocate a {} byte line buffer for '{}'", reader.capacity, path);
+        close(reader.file);
+        return false;
+    }
+    return true;
+}
+
+void close(line_reader& reader)
+{
+    close(reader.file);
+    free(reader.buffer);
+    reader = {};
+}
+
+bool read_line(line_reader& reader, std::string_view& line)
+{
+    if (!reader.buffer)
+        return false;
+
+    for (;;)
+    {
+        const char* start{ reader.buffer + reader.begin };
+        const u64   available{ reader.end - reader.begin };
+        const char* newline{ (const char*) memchr(start, '\n', available) };
+        if (newline || (reader.eof && available))
+        {
+            u64 length{ newline ? (u64) (newline - start) : available };
+            reader.begin += newline ? length + 1 : length;
+            if (length && start[length - 1] == '\r')
+                --length;
+            line = { start, length };
+            return true;
+        }
+
+        if (reader.eof)
+            return false;
+
+        // Keep the partial line, moving it to the front, or if it already fills the buffer, making more room
+        if (reader.begin == 0 && reader.end == reader.capacity)
+        {
+            char* grown{ (char*) realloc(reader.buffer, reader.capacity * 2) };
+            if (!grown)
+            {
+                LOG_ERROR("Failed to grow a line buffer to {} bytes", reader.capacity * 2);
+                return false;
+            }
+            reader.buffer = grown;
+            reader.capacity *= 2;
+        } else
+        {
+            memmove(reader.buffer, start, available);
+            reader.begin = 0;
+            reader.end   = available;
+        }
+
+        const u64 wanted{ reader.capacity - reader.end };
+        const u64 got{ fread(reader.buffer + reader.end, 1, wanted, (FILE*) reader.file.handle) };
+        reader.end += got;
+        reader.eof = got < wanted;
+    }
+}
+
+namespace
+{
+static_assert((u8) map_hints::dont_need == (u8) platform::map_advice::dont_need);
+
+platform::mapped_file to_platform(const mapped_file& file)
+{
+    return { (u8*) file.data, file.size, file.file, file.mapping, false };
+}
+} // anonymous namespace
+
+bool map(const char* path, mapped_file& file, map_hints::hint hint)
+{
+    file = {};
+    platform::mapped_file mapping{};
+    if (!platform::map_file(path, 0, false, mapping))
+        return false;
+
+    file = { mapping.data, mapping.size, mapping.file, mapping.mapping };
+    if (hint != map_hints::normal)
+        advise(file, hint);
+    return true;
+}
+
+void unmap(mapped_file& file)
+{
+    platform::mapped_file mapping{ to_platform(file) };
+    platform::unmap_file(mapping);
+    file = {};
+}
+
+bool advise(const mapped_file& file, map_hints::hint hint, u64 offset, u64 size)
+{
+    return platform::advise_mapped(to_platform(file), offset, size, (platform::map_advice::advice) hint);
+}
 } // namespace sky::utl::fs
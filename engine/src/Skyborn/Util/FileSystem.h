@@ -26,7 +26,9 @@
 #include "Skyborn/Defines.h"
 #include "Vector.h"
 
+#include <span>
 #include <string>
+#include <string_view>
 
 #define FILE_BEGIN SEEK_SET
 #define FILE_END SEEK_END
@@ -41,6 +43,41 @@ struct file_handle
     bool  is_valid;
 };
 
+// A read only file mapped into memory. Reading it faults pages in from the page cache instead of copying them
+struct mapped_file
+{
+    const u8* data;
+    u64       size;
+    void*     file;    // Native handles, for unmap
+    void*     mapping;
+
+    [[nodiscard]] std::span<const u8> bytes() const { return { data, size }; }
+};
+
+// Reads a text file a line at a time through one large buffer, handing out views into it rather than copies
+struct line_reader
+{
+    file_handle file;
+    char*       buffer;
+    u64         capacity;
+    u64         begin; // Start of what hasn't been handed out yet
+    u64         end;   // End of what's been read into the buffer
+    bool        eof;
+};
+
+// Mirrors platform::map_advice
+struct map_hints
+{
+    enum hint : u8
+    {
+        normal,
+        sequential, // Read ahead aggressively, pages behind can go
+        random,     // Don't read ahead
+        will_need,  // Start reading the range in now
+        dont_need,  // The range can be dropped from memory; it's read in again if touched
+    };
+};
+
 struct file_modes
 {
     enum mode : u8
@@ -73,4 +110,48 @@ SAPI bool write_line(const file_handle& handle, const char* text);
 
 SAPI bool write(const file_handle& handle, u64 size, const void* data, u64& written);
 
+/**
+ * Opens a text file for read_line
+ * @param path The file
+ * @param reader Receives the reader
+ * @param buffer_size Bytes read from the file at a time. Grows if a line is longer
+ * @return true if the file was opened, false otherwise
+ */
+SAPI bool open(const char* path, line_reader& reader, u64 buffer_size = 1_MB);
+
+SAPI void close(line_reader& reader);
+
+/**
+ * Reads the next line, without its \n or \r\n. The last line needn't end with a newline
+ * @param reader The reader
+ * @param line Receives the line, valid until the next call
+ * @return false once the file is exhausted
+ */
+SAPI bool read_line(line_reader& reader, std::string_view& line);
+
+/**
+ * Maps a whole file read only. An empty file maps to no data
+ * @param path The file
+ * @param file Receives the mapping, valid until unmapped
+ * @param hint How it will be read, see advise
+ * @return true if the file was mapped, false otherwise
+ */
+SAPI bool map(const char* path, mapped_file& file, map_hints::hint hint = map_hints::normal);
+
+SAPI void unmap(mapped_file& file);
+
+/**
+ * Hints how a range of a mapped file will be read, e.g. sequentially or soon
+ * @param offset Start of the range. Rounded down to a page on platforms that need it
+ * @param size Length of the range, 0 for the rest of the file
+ * @return false if the platform didn't take the hint, which is harmless
+ */
+SAPI bool advise(const mapped_file& file, map_hints::hint hint, u64 offset = 0, u64 size = 0);
+
+// Starts reading a range in the background, so the first touch doesn't stall on the disk
+inline bool prefetch(const mapped_file& file, u64 offset = 0, u64 size = 0)
+{
+    return advise(file, map_hints::will_need, offset, size);
+}
+
 } // namespace sky::utl::fs
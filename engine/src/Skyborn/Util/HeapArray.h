@@ -26,6 +26,9 @@
 
 #include "Skyborn/Debug/Asserts.h"
 
+#include <cstdlib>
+#include <cstring>
+
 namespace sky::utl
 {
 template<typename T>
@@ -24,7 +24,9 @@
 #pragma once
 #include "Skyborn/Defines.h"
 
+#include <cmath>
 #include <format>
+#include <limits>
 
 #ifndef SKY_USE_SIMD
     #define SKY_USE_SIMD 0
@@ -33,7 +35,11 @@
 #endif
 
 #if SKY_USE_SIMD
-    #include <intrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <immintrin.h>
+    #endif
     #include <xmmintrin.h>
 
     #define MAKE_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
@@ -25,7 +25,9 @@
 
 #include "Skyborn/Defines.h"
 
+#include <cstring>
 #include <thread>
+#include <typeinfo>
 
 namespace sky::utl
 {
@@ -41,4 +43,33 @@ inline void sleep(u32 milliseconds)
     std::this_thread::sleep_for(std::chrono::milliseconds{ milliseconds });
 }
 
+// One per type and module, so its address tells types apart within a module
+template<typename T>
+inline constexpr char type_tag{};
+
+// typeid names are the same in every module, so they identify a type across the DLL boundary. Types in anonymous
+// namespaces are the exception: the same name in two translation units can be two different types. Those can't be
+// shared between modules anyway, so they're told apart by their type_tag instead
+struct type_key
+{
+    const char* name{};
+    const void* tag{};
+};
+
+template<typename T>
+type_key type_key_of()
+{
+    return { typeid(T).name(), &type_tag<T> };
+}
+
+inline bool same_type(const type_key& a, const type_key& b)
+{
+    if (!string_compare(a.name, b.name))
+        return false;
+
+    // GCC and Clang mangle anonymous namespaces as _GLOBAL__N_, MSVC names them `anonymous namespace'
+    const bool internal{ strstr(a.name, "_GLOBAL__N_") || strstr(a.name, "anonymous namespace") };
+    return !internal || a.tag == b.tag;
+}
+
 } // namespace sky::utl
\ No newline at end of file
@@ -26,6 +26,9 @@
 #include "Skyborn/Defines.h"
 #include "Skyborn/Debug/Asserts.h"
 
+#include <cstdlib>
+#include <cstring>
+
 template<typename T>
 concept vector_enabled = std::is_copy_constructible_v<T> && std::is_default_constructible_v<T>;
 
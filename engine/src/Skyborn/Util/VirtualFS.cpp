@@ -0,0 +1,438 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: VirtualFS.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#include "VirtualFS.h"
+
+#include "Vector.h"
+#include "Skyborn/Debug/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace sky::utl::vfs
+{
+namespace
+{
+constexpr u32 pack_magic   = 0x504b5953; // "SKYP"
+constexpr u32 pack_version = 1;
+
+// A pack is this header, the entries' data, their names, then the table of contents: an open addressed hash table
+// of entries keyed by the hash of their path
+struct pack_header
+{
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 slot_count; // Power of two
+    u64 names_offset;
+    u64 names_size;
+    u64 toc_offset;
+};
+
+struct entry_flags
+{
+    enum flag : u32
+    {
+        used     = 0x1,
+        checksum = 0x2,
+    };
+};
+
+struct pack_entry
+{
+    u64 hash;
+    u64 offset;
+    u64 size;
+    u32 name_offset; // Into the names block
+    u32 name_length;
+    u32 checksum;
+    u32 flags;
+};
+
+struct mount
+{
+    std::string        point; // Empty, or ending in /
+    std::string        directory;
+    fs::mapped_file    pack;
+    const pack_header* header;
+    const pack_entry*  toc;
+    const char*        names;
+    bool               is_pack;
+    bool               verify;
+};
+
+vector<mount*> mounts{};
+
+constexpr auto crc_table{ [] {
+    std::array<u32, 256> table{};
+    for (u32 i = 0; i < 256; ++i)
+    {
+        u32 crc{ i };
+        for (u32 bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+        table[i] = crc;
+    }
+    return table;
+}() };
+
+u32 crc32(std::span<const u8> data)
+{
+    u32 crc{ 0xffffffffu };
+    for (const u8 byte : data)
+        crc = (crc >> 8) ^ crc_table[(crc ^ byte) & 0xff];
+    return ~crc;
+}
+
+u64 hash_path(std::string_view path)
+{
+    u64 hash{ 0xcbf29ce484222325ull };
+    for (const char c : path)
+        hash = (hash ^ (u8) c) * 0x100000001b3ull;
+    return hash;
+}
+
+std::string normalize_point(const char* mount_point)
+{
+    std::string point{ mount_point ? mount_point : "" };
+    std::replace(point.begin(), point.end(), '\\', '/');
+    if (!point.empty() && point.back() != '/')
+        point += '/';
+    return point;
+}
+
+const pack_entry* find_entry(const mount& m, std::string_view path)
+{
+    const u64 hash{ hash_path(path) };
+    const u32 mask{ m.header->slot_count - 1 };
+    for (u32 slot = (u32) hash & mask, probe = 0; probe <= mask; slot = (slot + 1) & mask, ++probe)
+    {
+        const pack_entry& entry{ m.toc[slot] };
+        if (!(entry.flags & entry_flags::used))
+            return nullptr;
+
+        if (entry.hash == hash && std::string_view{ m.names + entry.name_offset, entry.name_length } == path)
+            return &entry;
+    }
+    return nullptr;
+}
+
+// The part of the path the mount serves, or false if it isn't under the mount point
+bool relative_to(const mount& m, std::string_view path, std::string_view& relative)
+{
+    if (!path.starts_with(m.point))
+        return false;
+
+    relative = path.substr(m.point.size());
+    return true;
+}
+
+bool map_pack(const char* pack_path, mount& m)
+{
+    if (!fs::map(pack_path, m.pack, fs::map_hints::random))
+        return false;
+
+    const u64 size{ m.pack.size };
+    m.header = (const pack_header*) m.pack.data;
+    if (size < sizeof(pack_header) || m.header->magic != pack_magic || m.header->version != pack_version)
+    {
+        LOG_ERROR("{} is not a pack this version can read", pack_path);
+        return false;
+    }
+
+    const pack_header& h{ *m.header };
+    if (!std::has_single_bit(h.slot_count) || h.toc_offset % alignof(pack_entry) || h.toc_offset > size ||
+        (size - h.toc_offset) / sizeof(pack_entry) < h.slot_count || h.names_offset > size ||
+        size - h.names_offset < h.names_size)
+    {
+        LOG_ERROR("{} has a damaged table of contents", pack_path);
+        return false;
+    }
+
+    m.toc   = (const pack_entry*) (m.pack.data + h.toc_offset);
+    m.names = (const char*) m.pack.data + h.names_offset;
+    for (u32 i = 0; i < h.slot_count; ++i)
+    {
+        const pack_entry& entry{ m.toc[i] };
+        if ((entry.flags & entry_flags::used) &&
+            (entry.offset > size || size - entry.offset < entry.size || entry.name_offset > h.names_size ||
+             h.names_size - entry.name_offset < entry.name_length))
+        {
+            LOG_ERROR("{} has an entry outside the pack", pack_path);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool write_all(const fs::file_handle& file, const void* data, u64 size)
+{
+    u64 written{};
+    return !size || fs::write(file, size, data, written);
+}
+
+bool write_padding(const fs::file_handle& file, u64 from, u64 to)
+{
+    constexpr u8 zeros[4096]{};
+    for (u64 remaining = to - from; remaining;)
+    {
+        const u64 size{ std::min<u64>(remaining, sizeof(zeros)) };
+        if (!write_all(file, zeros, size))
+            return false;
+        remaining -= size;
+    }
+    return true;
+}
+
+u64 align_up(u64 value, u64 alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // anonymous namespace
+
+bool build_pack(const char* directory, const char* pack_path, const pack_desc& desc)
+{
+    if (!std::has_single_bit(desc.alignment))
+    {
+        LOG_ERROR("Pack alignment must be a power of two");
+        return false;
+    }
+
+    struct source
+    {
+        u64 offset;
+        u64 size;
+        u32 name_offset;
+        u32 name_length;
+    };
+
+    // Lay everything out up front, so the pack is written front to back in one pass
+    std::error_code error;
+    std::string     names;
+    vector<source>  sources;
+    u64             offset{ align_up(sizeof(pack_header), desc.alignment) };
+    for (const auto& item : std::filesystem::recursive_directory_iterator{ directory, error })
+    {
+        if (!item.is_regular_file())
+            continue;
+
+        const std::string name{ item.path().lexically_relative(directory).generic_string() };
+        sources.push_back({ offset, item.file_size(), (u32) names.size(), (u32) name.size() });
+        names += name;
+        offset = align_up(offset + sources.back().size, desc.alignment);
+    }
+    if (error)
+    {
+        LOG_ERROR("Failed to list {}", directory);
+        return false;
+    }
+
+    const u32         slot_count{ std::bit_ceil(std::max<u32>((u32) sources.size() * 2, 2)) };
+    const pack_header header{ pack_magic, pack_version, (u32) sources.size(), slot_count, offset, names.size(),
+                              align_up(offset + names.size(), alignof(pack_entry)) };
+    vector<pack_entry> toc(slot_count, pack_entry{});
+
+    fs::file_handle file{};
+    if (!fs::open(pack_path, fs::file_modes::write, true, file))
+        return false;
+
+    bool ok{ write_all(file, &header, sizeof(header)) };
+    u64  at{ sizeof(header) };
+    for (const source& src : sources)
+    {
+        const std::string_view name{ names.data() + src.name_offset, src.name_length };
+        const std::string      path{ std::string{ directory } + "/" + std::string{ name } };
+        fs::mapped_file        data{};
+        ok = ok && fs::map(path.c_str(), data, fs::map_hints::sequential) && data.size == src.size &&
+             write_padding(file, at, src.offset) && write_all(file, data.data, data.size);
+        if (!ok)
+        {
+            fs::unmap(data);
+            break;
+        }
+        at = src.offset + src.size;
+
+        pack_entry entry{ hash_path(name), src.offset, src.size, src.name_offset, src.name_length,
+                          desc.checksums ? crc32(data.bytes()) : 0,
+                          entry_flags::used | (desc.checksums ? entry_flags::checksum : 0u) };
+        fs::unmap(data);
+
+        u32 slot{ (u32) entry.hash & (slot_count - 1) };
+        while (toc[slot].flags & entry_flags::used)
+        {
+            if (toc[slot].hash == entry.hash)
+            {
+                LOG_ERROR("{} and {} have the same hash; rename one", name,
+                          std::string_view{ names.data() + toc[slot].name_offset, toc[slot].name_length });
+                ok = false;
+            }
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        toc[slot] = entry;
+    }
+
+    ok = ok && write_padding(file, at, header.names_offset) && write_all(file, names.data(), names.size()) &&
+         write_padding(file, header.names_offset + names.size(), header.toc_offset) &&
+         write_all(file, toc.data(), toc.size() * sizeof(pack_entry));
+    fs::close(file);
+
+    if (!ok)
+    {
+        LOG_ERROR("Failed to write pack {}", pack_path);
+        return false;
+    }
+
+    LOG_INFO("Packed {} files from {} into {}", sources.size(), directory, pack_path);
+    return true;
+}
+
+bool mount_pack(const char* pack_path, const char* mount_point, bool verify)
+{
+    auto* m{ new mount{} };
+    if (!map_pack(pack_path, *m))
+    {
+        fs::unmap(m->pack);
+        delete m;
+        return false;
+    }
+
+    m->point   = normalize_point(mount_point);
+    m->is_pack = true;
+    m->verify  = verify;
+    mounts.push_back(m);
+    LOG_INFO("Mounted pack {} at '{}' ({} files)", pack_path, m->point, m->header->entry_count);
+    return true;
+}
+
+bool mount_directory(const char* directory, const char* mount_point)
+{
+    if (!std::filesystem::is_directory(directory))
+    {
+        LOG_ERROR("Can't mount {}, it isn't a directory", directory);
+        return false;
+    }
+
+    auto* m{ new mount{} };
+    m->point     = normalize_point(mount_point);
+    m->directory = directory;
+    if (m->directory.back() != '/' && m->directory.back() != '\\')
+        m->directory += '/';
+    mounts.push_back(m);
+    LOG_INFO("Mounted directory {} at '{}'", directory, m->point);
+    return true;
+}
+
+bool unmount(const char* mount_point)
+{
+    const std::string point{ normalize_point(mount_point) };
+    bool              found{};
+    for (u64 i = 0; i < mounts.size();)
+    {
+        if (mounts[i]->point != point)
+        {
+            ++i;
+            continue;
+        }
+
+        fs::unmap(mounts[i]->pack);
+        delete mounts[i];
+        mounts.erase(i); // Keeps the order, which is the precedence
+        found = true;
+    }
+    return found;
+}
+
+void unmount_all()
+{
+    for (mount* m : mounts)
+    {
+        fs::unmap(m->pack);
+        delete m;
+    }
+    mounts.clear();
+}
+
+bool exists(const char* path)
+{
+    for (u64 i = mounts.size(); i-- > 0;)
+    {
+        const mount&     m{ *mounts[i] };
+        std::string_view relative;
+        if (!relative_to(m, path, relative))
+            continue;
+
+        if (m.is_pack ? find_entry(m, relative) != nullptr
+                      : fs::exists((m.directory + std::string{ relative }).c_str()))
+            return true;
+    }
+    return false;
+}
+
+bool open(const char* path, asset& file)
+{
+    file = {};
+    for (u64 i = mounts.size(); i-- > 0;)
+    {
+        const mount&     m{ *mounts[i] };
+        std::string_view relative;
+        if (!relative_to(m, path, relative))
+            continue;
+
+        if (!m.is_pack)
+        {
+            const std::string loose{ m.directory + std::string{ relative } };
+            if (!fs::exists(loose.c_str()) || !fs::map(loose.c_str(), file.loose))
+                continue;
+
+            file.data = file.loose.data;
+            file.size = file.loose.size;
+            return true;
+        }
+
+        const pack_entry* entry{ find_entry(m, relative) };
+        if (!entry)
+            continue;
+
+        file.data = m.pack.data + entry->offset;
+        file.size = entry->size;
+        if (m.verify && (entry->flags & entry_flags::checksum) && crc32(file.bytes()) != entry->checksum)
+        {
+            LOG_ERROR("{} failed its checksum", path);
+            file = {};
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+void close(asset& file)
+{
+    fs::unmap(file.loose);
+    file = {};
+}
+} // namespace sky::utl::vfs
@@ -0,0 +1,89 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: VirtualFS.h
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Skyborn/Defines.h"
+#include "FileSystem.h"
+
+#include <span>
+
+// Virtual file system. Asset paths resolve through mount points to either a pack archive or a loose directory.
+// Packs are memory-mapped and indexed by a hash table of their paths, so opening an asset from one is a hash lookup
+// and a pointer into the mapping, with no syscalls. Loose directories are for development.
+// Mount everything before loading assets from other threads
+namespace sky::utl::vfs
+{
+// An opened asset. Assets from a pack point into its mapping, so they must be closed before it's unmounted
+struct asset
+{
+    const u8*       data;
+    u64             size;
+    fs::mapped_file loose; // Set when the asset came from a loose file
+
+    [[nodiscard]] std::span<const u8> bytes() const { return { data, size }; }
+};
+
+struct pack_desc
+{
+    u32  alignment{ 64 };   // Every entry starts on a multiple of this. Power of two
+    bool checksums{ true }; // Store a CRC32 of every entry
+};
+
+/**
+ * Writes every file under a directory into a pack archive
+ * @param directory Root of the files. Their paths in the pack are relative to it, with / separators
+ * @param pack_path The pack to write
+ * @param desc Entry alignment and checksums
+ * @return true if the pack was written, false otherwise
+ */
+SAPI bool build_pack(const char* directory, const char* pack_path, const pack_desc& desc = {});
+
+/**
+ * Mounts a pack archive. Later mounts take precedence over earlier ones for the paths they share
+ * @param pack_path The pack
+ * @param mount_point Prefix of the paths it serves, e.g. "textures/", or "" for everything
+ * @param verify Check an entry's checksum on every open. Costs a full read of the asset
+ * @return true if the pack was mapped and its table of contents is sound, false otherwise
+ */
+SAPI bool mount_pack(const char* pack_path, const char* mount_point = "", bool verify = false);
+
+// Mounts a directory of loose files
+SAPI bool mount_directory(const char* directory, const char* mount_point = "");
+
+// Unmounts everything mounted at the point. Returns false if nothing was
+SAPI bool unmount(const char* mount_point);
+SAPI void unmount_all();
+
+[[nodiscard]] SAPI bool exists(const char* path);
+
+/**
+ * Opens an asset through the mounts, newest first
+ * @param path Path of the asset, with / separators
+ * @param file Receives the asset, valid until closed
+ * @return true if a mount had the asset, false otherwise
+ */
+SAPI bool open(const char* path, asset& file);
+SAPI void close(asset& file);
+} // namespace sky::utl::vfs
@@ -28,6 +28,13 @@
 #include "Tests/HeapArrayTest.h"
 #include "Tests/BitsTest.h"
 #include "Tests/MathsTest.h"
+#include "Tests/EcsTest.h"
+#include "Tests/EventTest.h"
+#include "Tests/FileSystemTest.h"
+#include "Tests/InputTest.h"
+#include "Tests/LoggerTest.h"
+#include "Tests/SnapshotTest.h"
+#include "Tests/TimerTest.h"
 
 
 #include <Skyborn/Debug/Logger.h>
@@ -39,6 +46,13 @@ int main(int argc, char** argv)
     register_heap_array_tests();
     register_bits_tests();
     register_math_tests();
+    register_ecs_tests();
+    register_event_tests();
+    register_filesystem_tests();
+    register_input_tests();
+    register_logger_tests();
+    register_snapshot_tests();
+    register_timer_tests();
 
     tests::run_tests();
 
@@ -0,0 +1,72 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: AllocCounter.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "AllocCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local u64 allocations{};
+} // anonymous namespace
+
+// Replaces the global allocation functions for the whole testbed, so tests can check a path doesn't allocate.
+// Kept in its own file so the replacement isn't mistaken for part of any one test
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    free(p);
+}
+
+u64 thread_allocations()
+{
+    return allocations;
+}
@@ -0,0 +1,351 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: EcsTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "EcsTest.h"
+
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/ECS/CommandBuffer.h>
+#include <Skyborn/ECS/Scheduler.h>
+
+#include <thread>
+
+using namespace sky;
+
+namespace
+{
+struct position
+{
+    f32 x, y;
+};
+
+struct velocity
+{
+    f32 x, y;
+};
+
+struct frozen
+{};
+
+struct health
+{
+    f32 value;
+};
+} // anonymous namespace
+
+u8 stale_handles_are_detected()
+{
+    ecs::world  w{};
+    ecs::entity e{ w.create(position{ 1.f, 2.f }) };
+    expects_to_be_true(w.is_alive(e));
+    expect_should_be(1, w.entity_count());
+
+    w.destroy(e);
+    expects_to_be_false(w.is_alive(e));
+    expect_should_be(0, w.entity_count());
+
+    // The index is recycled but the old handle stays dead
+    ecs::entity reused{ w.create() };
+    expect_should_be(e.index, reused.index);
+    expects_to_be_false(w.is_alive(e));
+    expects_to_be_true(w.get<position>(e) == nullptr);
+
+    return pass;
+}
+
+u8 components_survive_archetype_moves()
+{
+    ecs::world  w{};
+    ecs::entity e{ w.create(position{ 3.f, 4.f }) };
+    w.add(e, velocity{ 1.f, -1.f });
+    w.add<frozen>(e);
+
+    expects_to_be_true(w.has<frozen>(e));
+    expect_float_to_equal(3.f, w.get<position>(e)->x);
+    expect_float_to_equal(-1.f, w.get<velocity>(e)->y);
+
+    w.remove<velocity>(e);
+    expects_to_be_false(w.has<velocity>(e));
+    expect_float_to_equal(4.f, w.get<position>(e)->y);
+
+    return pass;
+}
+
+u8 queries_pick_up_new_archetypes()
+{
+    ecs::world w{};
+    ecs::query& moving{ w.query_of<position, velocity>() };
+    expect_should_be(0, moving.count());
+
+    w.create(position{}, velocity{ 1.f, 1.f });
+    w.create(position{}, velocity{ 2.f, 2.f }, frozen{});
+    w.create(position{});
+    expect_should_be(2, moving.count());
+
+    ecs::component_mask without_frozen{};
+    without_frozen.set(ecs::component<frozen>());
+    ecs::query& active{ w.find_query(ecs::mask_of<position, velocity>(), without_frozen) };
+    expect_should_be(1, active.count());
+
+    moving.each<position, velocity>([](position& p, const velocity& v) {
+        p.x += v.x;
+        p.y += v.y;
+    });
+
+    f32 sum = 0.f;
+    w.each<position>([&](ecs::entity, const position& p) { sum += p.x; });
+    expect_float_to_equal(3.f, sum);
+
+    return pass;
+}
+
+u8 chunks_stay_dense()
+{
+    ecs::world w{};
+    utl::vector<ecs::entity> entities{};
+    for (u32 i = 0; i < 5000; ++i)
+        entities.push_back(w.create(position{ (f32) i, 0.f }));
+
+    const ecs::archetype* arch{ w.query_of<position>().archetypes()[0] };
+    expects_to_be_true(arch->capacity() > 1);
+    expect_should_be(5000, arch->entity_count());
+    expect_should_be((5000 + arch->capacity() - 1) / arch->capacity(), arch->chunk_count());
+
+    for (u32 i = 0; i < 5000; i += 2)
+        w.destroy(entities[i]);
+
+    expect_should_be(2500, arch->entity_count());
+    expect_should_be((2500 + arch->capacity() - 1) / arch->capacity(), arch->chunk_count());
+    for (u64 i = 0; i + 1 < arch->chunk_count(); ++i)
+    {
+        expect_should_be(arch->capacity(), arch->chunk_at(i).count);
+    }
+
+    // Survivors still see their own values after being swapped around
+    expect_float_to_equal(4999.f, w.get<position>(entities[4999])->x);
+    expect_float_to_equal(1.f, w.get<position>(entities[1])->x);
+
+    return pass;
+}
+
+u8 command_buffer_defers_changes()
+{
+    ecs::world          w{};
+    ecs::command_buffer cmds{ w };
+    ecs::entity         keep{ w.create(position{}) };
+    ecs::entity         gone{ w.create(position{}) };
+
+    w.each<position>([&](ecs::entity e, position&) {
+        if (e == gone)
+            cmds.destroy(e);
+        else
+            cmds.add(e, velocity{ 5.f, 0.f });
+    });
+
+    ecs::entity spawned{ cmds.create() };
+    cmds.add(spawned, position{ 7.f, 8.f });
+    expects_to_be_false(w.is_alive(spawned));
+    expect_should_be(2, w.entity_count());
+
+    cmds.playback();
+    expects_to_be_true(cmds.empty());
+    expects_to_be_false(w.is_alive(gone));
+    expect_float_to_equal(5.f, w.get<velocity>(keep)->x);
+    expects_to_be_true(w.is_alive(spawned));
+    expect_float_to_equal(8.f, w.get<position>(spawned)->y);
+
+    return pass;
+}
+
+u8 command_buffers_create_from_many_threads()
+{
+    // Some of the handles come from the free list and the rest from past the end of the records
+    ecs::world  w{};
+    ecs::entity freed[8]{};
+    for (auto& e : freed)
+        e = w.create(position{});
+    for (const auto& e : freed)
+        w.destroy(e);
+
+    constexpr u32 thread_count = 4;
+    constexpr u32 per_thread   = 64;
+    ecs::command_buffer* buffers[thread_count]{};
+    ecs::entity          created[thread_count][per_thread]{};
+    std::thread          threads[thread_count];
+    for (u32 t = 0; t < thread_count; ++t)
+    {
+        buffers[t] = new ecs::command_buffer{ w };
+        threads[t] = std::thread{ [&, t] {
+            for (u32 i = 0; i < per_thread; ++i)
+            {
+                created[t][i] = buffers[t]->create();
+                buffers[t]->add(created[t][i], position{ (f32) t, (f32) i });
+            }
+        } };
+    }
+    for (auto& t : threads)
+        t.join();
+
+    // The last buffer never plays back, so its handles are given back instead
+    for (u32 t = 0; t < thread_count - 1; ++t)
+        buffers[t]->playback();
+    buffers[thread_count - 1]->clear();
+
+    expect_should_be((thread_count - 1) * per_thread, w.entity_count());
+    for (u32 t = 0; t < thread_count; ++t)
+    {
+        for (u32 i = 0; i < per_thread; ++i)
+        {
+            const ecs::entity e{ created[t][i] };
+            expect_should_be(t < thread_count - 1, w.is_alive(e));
+            if (t < thread_count - 1)
+                expect_float_to_equal((f32) i, w.get<position>(e)->y);
+        }
+        delete buffers[t];
+    }
+
+    // Released indices are reused, but not by their old handles
+    const ecs::entity released{ created[thread_count - 1][per_thread - 1] };
+    const ecs::entity reused{ w.create() };
+    expect_should_be(released.index, reused.index);
+    expects_to_be_false(w.is_alive(released));
+
+    return pass;
+}
+
+u8 scheduler_orders_conflicting_systems()
+{
+    ecs::world     w{};
+    ecs::scheduler s{ w, { 0 } };
+
+    auto noop = [](const ecs::chunk_view&) {};
+    const u32 move{ s.add_system({ "move", ecs::mask_of<velocity>(), ecs::mask_of<position>(), {}, noop }) };
+    const u32 heal{ s.add_system({ "heal", {}, ecs::mask_of<health>(), {}, noop }) };
+    const u32 draw{ s.add_system({ "draw", ecs::mask_of<position, health>(), {}, {}, noop }) };
+    const u32 read{ s.add_system({ "read", ecs::mask_of<velocity>(), {}, {}, noop }) };
+
+    expect_should_be(0, s.stage_of(move));
+    expect_should_be(0, s.stage_of(heal));
+    expect_should_be(1, s.stage_of(draw));
+    expect_should_be(0, s.stage_of(read));
+    expect_should_be(2, s.stage_count());
+
+    return pass;
+}
+
+u8 scheduler_runs_every_chunk_once()
+{
+    ecs::world w{};
+    for (u32 i = 0; i < 20000; ++i)
+        w.create(position{ 0.f, 0.f }, velocity{ 1.f, 2.f }, health{ (f32) (i % 3) });
+
+    ecs::scheduler s{ w, { 3, true } };
+    s.add_system({ "move", ecs::mask_of<velocity>(), ecs::mask_of<position>(), {}, [](const ecs::chunk_view& view) {
+                      position*       p{ view.get<position>() };
+                      const velocity* v{ view.get<const velocity>() };
+                      for (u32 i = 0; i < view.count(); ++i)
+                      {
+                          p[i].x += v[i].x;
+                          p[i].y += v[i].y;
+                      }
+                  } });
+    s.add_system({ "heal", {}, ecs::mask_of<health>(), {}, [](const ecs::chunk_view& view) {
+                      health* h{ view.get<health>() };
+                      for (u32 i = 0; i < view.count(); ++i)
+                          h[i].value += 1.f;
+                  } });
+
+    const u32 violations{ ecs::access_violation_count() };
+    s.run();
+    s.run();
+    expect_should_be(violations, ecs::access_violation_count());
+
+    f32 sum_x = 0.f;
+    f32 sum_health = 0.f;
+    w.each<position, health>([&](const position& p, const health& h) {
+        sum_x += p.x;
+        sum_health += h.value;
+    });
+    expect_float_to_equal(40000.f, sum_x);
+    expect_float_to_equal(19999.f + 2.f * 20000.f, sum_health);
+
+    return pass;
+}
+
+u8 scheduler_reports_undeclared_access()
+{
+    ecs::world w{};
+    w.create(position{}, velocity{});
+
+    ecs::scheduler s{ w, { 0, true } };
+    s.add_system({ "sneaky", ecs::mask_of<position>(), {}, {}, [](const ecs::chunk_view& view) {
+                      (void) view.get<const position>();
+                      (void) view.get<position>();
+                  } });
+
+    const u32 violations{ ecs::access_violation_count() };
+    s.run();
+    expect_should_be(violations + 1, ecs::access_violation_count());
+
+    return pass;
+}
+
+u8 same_named_local_components_get_their_own_ids()
+{
+    // What another translation unit's anonymous position would register: the same typeid name, but another type
+    static constexpr char other_tag{};
+    const ecs::component_id other{ ecs::register_component(
+        { typeid(position).name(), 3 * sizeof(f64), alignof(f64), &other_tag }) };
+    expects_to_be_true(other != u32_invalid);
+    expects_to_be_true(other != ecs::component<position>());
+    expect_should_be(3 * sizeof(f64), ecs::get_component_info(other).size);
+    expect_should_be(sizeof(position), ecs::get_component_info(ecs::component<position>()).size);
+
+    // Registering either one again finds it
+    expect_should_be(other, ecs::register_component({ typeid(position).name(), 3 * sizeof(f64), alignof(f64),
+                                                      &other_tag }));
+    return pass;
+}
+
+void register_ecs_tests()
+{
+    tests::register_test(stale_handles_are_detected, "ECS handles should go stale once their entity is destroyed");
+    tests::register_test(components_survive_archetype_moves,
+                         "ECS components should keep their values when an entity changes archetype");
+    tests::register_test(queries_pick_up_new_archetypes,
+                         "ECS cached queries should include archetypes created after the query");
+    tests::register_test(chunks_stay_dense, "ECS chunks should stay full except the last after removals");
+    tests::register_test(command_buffer_defers_changes,
+                         "ECS command buffers should apply structural changes on playback");
+    tests::register_test(command_buffers_create_from_many_threads,
+                         "ECS command buffers on different threads should reserve distinct handles");
+    tests::register_test(scheduler_orders_conflicting_systems,
+                         "ECS scheduler should only share a stage between systems that don't conflict");
+    tests::register_test(scheduler_runs_every_chunk_once,
+                         "ECS scheduler should run every chunk of every system exactly once across workers");
+    tests::register_test(scheduler_reports_undeclared_access,
+                         "ECS scheduler should report components a system didn't declare");
+    tests::register_test(same_named_local_components_get_their_own_ids,
+                         "ECS components in anonymous namespaces should get their own ids");
+}
\ No newline at end of file
@@ -0,0 +1,546 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: EventTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "EventTest.h"
+
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/Core/Event.h>
+#include <Skyborn/Core/Recorder.h>
+
+#include <filesystem>
+#include <string>
+#include <thread>
+
+using namespace sky;
+
+namespace
+{
+constexpr u16 test_code_a       = 0x200;
+constexpr u16 test_code_b       = 0x201;
+constexpr u16 test_code_unsized = 0x202;
+
+struct received
+{
+    u16 codes[16]{};
+    u32 values[16]{};
+    u32 count{};
+};
+
+bool record(u16 code, void*, void* listener, void* data)
+{
+    auto& r{ *(received*) listener };
+    r.codes[r.count]  = code;
+    r.values[r.count] = data ? *(u32*) data : 0;
+    ++r.count;
+    return false;
+}
+
+struct unit_spawned
+{
+    u32 unit;
+};
+
+bool repost(u16 code, void*, void* listener, void* data)
+{
+    record(code, nullptr, listener, data);
+    const u32 value{ *(u32*) data + 1 };
+    events::post(test_code_b, nullptr, &value, sizeof(value));
+    return false;
+}
+} // anonymous namespace
+
+u8 queued_events_wait_for_dispatch()
+{
+    events::initialize();
+    received r{};
+    events::register_event(test_code_a, &r, record);
+    events::register_event(test_code_b, &r, record);
+
+    for (u32 value : { 1u, 2u, 3u })
+    {
+        events::post(value == 2 ? test_code_b : test_code_a, nullptr, &value, sizeof(value));
+    }
+    expect_should_be(0, r.count);
+    expect_should_be(3, events::queued_count());
+
+    events::dispatch_queued();
+    expect_should_be(0, events::queued_count());
+    expect_should_be(3, r.count);
+
+    // Grouped by code, in posting order within a code
+    expect_should_be(test_code_a, r.codes[0]);
+    expect_should_be(1, r.values[0]);
+    expect_should_be(test_code_a, r.codes[1]);
+    expect_should_be(3, r.values[1]);
+    expect_should_be(test_code_b, r.codes[2]);
+    expect_should_be(2, r.values[2]);
+
+    events::shutdown();
+    return pass;
+}
+
+u8 posting_during_dispatch_defers_to_next_batch()
+{
+    events::initialize();
+    received r{};
+    events::register_event(test_code_a, &r, repost);
+    events::register_event(test_code_b, &r, record);
+
+    const u32 value = 10;
+    events::post(test_code_a, nullptr, &value, sizeof(value));
+    events::dispatch_queued();
+    expect_should_be(1, r.count);
+    expect_should_be(1, events::queued_count());
+
+    events::dispatch_queued();
+    expect_should_be(2, r.count);
+    expect_should_be(11, r.values[1]);
+
+    const u8 too_big[events::max_payload_size + 1]{};
+    expects_to_be_false(events::post(test_code_a, nullptr, too_big, sizeof(too_big)));
+
+    events::shutdown();
+    return pass;
+}
+
+void sum_u32(void* into, const void* from)
+{
+    *(u32*) into += *(const u32*) from;
+}
+
+u8 coalesced_events_fire_once_per_dispatch()
+{
+    events::initialize();
+    received r{};
+    events::register_event(events::system_event::mouse_moved, &r, record);
+    events::register_event(test_code_a, &r, record);
+    events::set_coalescing(test_code_a, events::coalesce::accumulate, sum_u32);
+
+    for (u32 value = 1; value <= 4; ++value)
+    {
+        events::post(events::system_event::mouse_moved, nullptr, &value, sizeof(value));
+        events::post(test_code_a, nullptr, &value, sizeof(value));
+    }
+    expect_should_be(2, events::queued_count());
+
+    events::dispatch_queued();
+    expect_should_be(2, r.count);
+    expect_should_be(4, r.values[0]);  // Last value wins
+    expect_should_be(10, r.values[1]); // 1 + 2 + 3 + 4
+
+    // A new batch starts fresh
+    const u32 value = 7;
+    events::post(test_code_a, nullptr, &value, sizeof(value));
+    events::dispatch_queued();
+    expect_should_be(7, r.values[2]);
+
+    events::set_coalescing(test_code_a, events::coalesce::none);
+    events::post(test_code_a, nullptr, &value, sizeof(value));
+    events::post(test_code_a, nullptr, &value, sizeof(value));
+    expect_should_be(2, events::queued_count());
+
+    events::shutdown();
+    return pass;
+}
+
+struct damage_taken
+{
+    u32 amount;
+    u32 target;
+};
+
+struct level_loaded
+{
+    const char* name;
+};
+
+struct wave_started
+{
+    u32 wave;
+};
+
+struct wave_handlers
+{
+    events::subscription subs[3]{};
+    u32                  calls[3]{};
+};
+
+bool count_fires(u16 code, void*, void* listener, void*)
+{
+    *(u32*) listener += code;
+    return false;
+}
+
+u8 user_codes_are_found_after_growing()
+{
+    events::initialize();
+    u32 total = 0;
+
+    // Enough codes to make the user code table grow a few times, spread across the code range
+    for (u32 i = 0; i < 200; ++i)
+        expects_to_be_true(events::register_event((u16) (0x100 + i * 300), &total, count_fires));
+
+    expects_to_be_false(events::register_event(0x100 + 300, &total, count_fires));
+    expects_to_be_false(events::fire(0x101, nullptr, nullptr));
+    expect_should_be(0, total);
+
+    u32 expected = 0;
+    for (u32 i = 0; i < 200; ++i)
+    {
+        events::fire((u16) (0x100 + i * 300), nullptr, nullptr);
+        expected += (u16) (0x100 + i * 300);
+    }
+    expect_should_be(expected, total);
+
+    expects_to_be_true(events::unregister_event(0x100 + 600, &total, count_fires));
+    expects_to_be_false(events::unregister_event(0x100 + 600, &total, count_fires));
+
+    events::shutdown();
+    return pass;
+}
+
+u8 typed_events_reach_their_own_handlers()
+{
+    u32 total_damage = 0;
+    u32 levels       = 0;
+
+    const events::subscription first{ events::subscribe<damage_taken>(
+        [&total_damage](const damage_taken& e) { total_damage += e.amount; }) };
+    events::subscribe<damage_taken>([](const damage_taken& e) { return e.target == 0; });
+    events::subscribe<damage_taken>([&total_damage](const damage_taken&) { total_damage += 1000; });
+    events::subscribe<level_loaded>([&levels](const level_loaded&) { ++levels; });
+
+    // The second handler consumes damage to target 0, so the third never sees it
+    expects_to_be_true(events::emit(damage_taken{ 5, 0 }));
+    expect_should_be(5, total_damage);
+
+    expects_to_be_false(events::emit(damage_taken{ 7, 1 }));
+    expect_should_be(1012, total_damage);
+    expect_should_be(0, levels);
+
+    events::emit(level_loaded{ "test" });
+    expect_should_be(1, levels);
+
+    expects_to_be_true(events::unsubscribe(first));
+    expects_to_be_false(events::unsubscribe(first));
+    events::emit(damage_taken{ 7, 1 });
+    expect_should_be(2012, total_damage);
+
+    events::initialize();
+    events::shutdown();
+    expects_to_be_false(events::emit(damage_taken{ 7, 1 }));
+    expect_should_be(2012, total_damage);
+
+    return pass;
+}
+
+u8 handlers_can_unsubscribe_while_emitting()
+{
+    // The first handler removes itself and the second. Neither shift may skip the third or run anything twice
+    static wave_handlers h{};
+    h.subs[0] = events::subscribe<wave_started>([](const wave_started&) {
+        ++h.calls[0];
+        events::unsubscribe(h.subs[0]);
+        events::unsubscribe(h.subs[1]);
+    });
+    h.subs[1] = events::subscribe<wave_started>([](const wave_started&) { ++h.calls[1]; });
+    h.subs[2] = events::subscribe<wave_started>([](const wave_started&) { ++h.calls[2]; });
+
+    events::emit(wave_started{ 1 });
+    expect_should_be(1, h.calls[0]);
+    expect_should_be(0, h.calls[1]);
+    expect_should_be(1, h.calls[2]);
+
+    events::emit(wave_started{ 2 });
+    expect_should_be(1, h.calls[0]);
+    expect_should_be(0, h.calls[1]);
+    expect_should_be(2, h.calls[2]);
+
+    expects_to_be_false(events::unsubscribe(h.subs[0]));
+    expects_to_be_true(events::unsubscribe(h.subs[2]));
+    return pass;
+}
+
+u8 same_named_local_events_get_their_own_ids()
+{
+    // What another translation unit's anonymous unit_spawned would use: the same typeid name, but another type
+    static constexpr char other_tag{};
+    const utl::type_key other{ typeid(unit_spawned).name(), &other_tag };
+    const u32           other_id{ events::detail::typed_event_id(other) };
+    expects_to_be_true(other_id != events::detail::event_type_id<unit_spawned>());
+    expect_should_be(other_id, events::detail::typed_event_id(other));
+    return pass;
+}
+
+struct producer_state
+{
+    u32 last_seen[4]{};
+    u32 received{};
+    bool in_order{ true };
+};
+
+bool check_producer_order(u16, void*, void* listener, void* data)
+{
+    auto&     state{ *(producer_state*) listener };
+    const u32 producer{ ((u32*) data)[0] };
+    const u32 sequence{ ((u32*) data)[1] };
+    if (sequence != state.last_seen[producer] + 1)
+        state.in_order = false;
+    state.last_seen[producer] = sequence;
+    ++state.received;
+    return false;
+}
+
+u8 posts_from_threads_keep_producer_order()
+{
+    events::initialize();
+    producer_state state{};
+    events::register_event(test_code_a, &state, check_producer_order);
+
+    constexpr u32 per_producer = 5000;
+    std::thread   producers[4];
+    for (u32 p = 0; p < 4; ++p)
+    {
+        producers[p] = std::thread{ [p] {
+            for (u32 i = 1; i <= per_producer; ++i)
+            {
+                const u32 payload[2]{ p, i };
+                while (!events::post_from_thread(test_code_a, nullptr, payload, sizeof(payload)))
+                    std::this_thread::yield();
+            }
+        } };
+    }
+
+    while (state.received < 4 * per_producer)
+        events::dispatch_queued();
+
+    for (auto& t : producers)
+        t.join();
+
+    expects_to_be_true(state.in_order);
+    expect_should_be(4 * per_producer, state.received);
+
+    events::shutdown();
+    expects_to_be_false(events::post_from_thread(test_code_a, nullptr, nullptr, 0));
+    return pass;
+}
+
+u32 call_order[4]{};
+u32 calls = 0;
+
+bool first_listener(u16, void*, void*, void*)
+{
+    call_order[calls++] = 1;
+    return false;
+}
+
+bool second_listener(u16, void*, void*, void*)
+{
+    call_order[calls++] = 2;
+    return false;
+}
+
+bool third_listener(u16, void*, void*, void* data)
+{
+    call_order[calls++] = 3;
+    return data != nullptr;
+}
+
+bool last_listener(u16, void*, void*, void*)
+{
+    call_order[calls++] = 4;
+    return false;
+}
+
+u8 listeners_run_by_priority()
+{
+    events::initialize();
+    int a, b, c, d;
+    events::register_event(test_code_a, &a, last_listener, -10);
+    events::register_event(test_code_a, &b, second_listener);
+    events::register_event(test_code_a, &c, first_listener, 10);
+    events::register_event(test_code_a, &d, third_listener);
+
+    events::fire(test_code_a, nullptr, nullptr);
+    expect_should_be(4, calls);
+    expect_should_be(1, call_order[0]);
+    expect_should_be(2, call_order[1]);
+    expect_should_be(3, call_order[2]);
+    expect_should_be(4, call_order[3]);
+
+    // Unregistering keeps the order of the rest
+    events::unregister_event(test_code_a, &b, second_listener);
+    calls = 0;
+    u32 handled = 1;
+    expects_to_be_true(events::fire(test_code_a, nullptr, &handled));
+    expect_should_be(2, calls);
+    expect_should_be(1, call_order[0]);
+    expect_should_be(3, call_order[1]);
+
+    const events::event_stats stats{ events::get_stats(test_code_a) };
+    expect_should_be(2, stats.fires);
+    expect_should_be(6, stats.invocations);
+    expect_should_be(1, stats.consumed);
+
+    events::listener_stats listeners[4]{};
+    expect_should_be(3, events::get_listener_stats(test_code_a, listeners, 4));
+    expect_should_be(10, listeners[0].priority);
+    expect_should_be(2, listeners[0].invocations);
+    expect_should_be(1, listeners[2].invocations);
+
+    events::reset_stats();
+    expect_should_be(0, events::get_stats(test_code_a).fires);
+
+    events::shutdown();
+    return pass;
+}
+
+// Drives three frames of posts and fires, with a dispatch at the end of each like app::run
+void run_recorded_frames()
+{
+    for (u32 frame = 0; frame < 3; ++frame)
+    {
+        events::dispatch_queued();
+        sky::recorder::begin_frame(frame);
+        const u32 value{ frame + 1 };
+        if (frame == 1)
+        {
+            u32 fired{ value * 10 };
+            events::fire(test_code_b, nullptr, &fired);
+            events::fire(test_code_unsized, nullptr, &fired);
+        } else
+        {
+            events::post(test_code_a, nullptr, &value, sizeof(value));
+        }
+    }
+    events::dispatch_queued();
+}
+
+u8 recorded_events_replay_in_order()
+{
+    const std::string path{ (std::filesystem::temp_directory_path() / "skyborn_recording_test.bin").string() };
+
+    events::initialize();
+    received live{};
+    events::register_event(test_code_a, &live, record);
+    events::register_event(test_code_b, &live, record);
+    events::register_event(test_code_unsized, &live, record);
+    expects_to_be_true(sky::recorder::set_payload_size(test_code_b, sizeof(u32)));
+
+    expects_to_be_true(sky::recorder::start_recording(path.c_str()));
+    run_recorded_frames();
+    expects_to_be_true(sky::recorder::stop_recording());
+    events::shutdown();
+
+    events::initialize();
+    received replayed{};
+    events::register_event(test_code_a, &replayed, record);
+    events::register_event(test_code_b, &replayed, record);
+    events::register_event(test_code_unsized, &replayed, record);
+
+    expects_to_be_true(sky::recorder::start_replay(path.c_str(), 1.f / 60.f, false));
+    f32 delta{};
+    expects_to_be_true(sky::recorder::fixed_delta(delta));
+    // The game raises the same events again while replaying. Only the recorded ones should be delivered
+    run_recorded_frames();
+    expects_to_be_true(sky::recorder::is_replaying());
+    sky::recorder::begin_frame(3);
+    expects_to_be_false(sky::recorder::is_replaying());
+
+    // The fire of a code without a payload size wasn't recorded, so the live one goes through instead
+    expect_should_be(4, live.count);
+    expect_should_be(test_code_unsized, live.codes[2]);
+    expect_should_be(live.count, replayed.count);
+    for (u32 i = 0; i < live.count; ++i)
+    {
+        expect_should_be(live.codes[i], replayed.codes[i]);
+        expect_should_be(live.values[i], replayed.values[i]);
+    }
+
+    events::shutdown();
+    std::filesystem::remove(path);
+    return pass;
+}
+
+u8 damaged_recordings_stop_replaying()
+{
+    const std::string path{ (std::filesystem::temp_directory_path() / "skyborn_damaged_recording_test.bin").string() };
+
+    events::initialize();
+    expects_to_be_true(sky::recorder::start_recording(path.c_str()));
+    run_recorded_frames();
+    expects_to_be_true(sky::recorder::stop_recording());
+    events::shutdown();
+
+    // Cut into the last record's payload, which is posted in the last frame
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    events::initialize();
+    received replayed{};
+    events::register_event(test_code_a, &replayed, record);
+    expects_to_be_true(sky::recorder::start_replay(path.c_str(), 1.f / 60.f, false));
+    for (u32 frame = 0; frame < 2; ++frame)
+    {
+        sky::recorder::begin_frame(frame);
+        events::dispatch_queued();
+    }
+    expects_to_be_true(sky::recorder::is_replaying());
+    expect_should_be(1, replayed.count);
+
+    sky::recorder::begin_frame(2);
+    events::dispatch_queued();
+    expects_to_be_false(sky::recorder::is_replaying());
+    expect_should_be(1, replayed.count);
+
+    events::shutdown();
+    std::filesystem::remove(path);
+    return pass;
+}
+
+void register_event_tests()
+{
+    tests::register_test(queued_events_wait_for_dispatch,
+                         "Posted events should only fire on dispatch, grouped by code");
+    tests::register_test(posting_during_dispatch_defers_to_next_batch,
+                         "Events posted while dispatching should wait for the next dispatch");
+    tests::register_test(coalesced_events_fire_once_per_dispatch,
+                         "Coalesced event codes should fire at most once per dispatch");
+    tests::register_test(user_codes_are_found_after_growing,
+                         "Listeners of user event codes should survive the code table growing");
+    tests::register_test(typed_events_reach_their_own_handlers,
+                         "Typed events should only reach handlers subscribed to their type");
+    tests::register_test(handlers_can_unsubscribe_while_emitting,
+                         "Typed event handlers should be able to unsubscribe while the event is being emitted");
+    tests::register_test(same_named_local_events_get_their_own_ids,
+                         "Typed events in anonymous namespaces should get their own ids");
+    tests::register_test(posts_from_threads_keep_producer_order,
+                         "Events posted from other threads should arrive in each thread's posting order");
+    tests::register_test(listeners_run_by_priority,
+                         "Listeners should run by priority, then registration order, and be counted");
+    tests::register_test(recorded_events_replay_in_order,
+                         "A recorded session should replay the same events in the same order");
+    tests::register_test(damaged_recordings_stop_replaying,
+                         "A replay should stop at a damaged record instead of reading past the recording");
+}
\ No newline at end of file
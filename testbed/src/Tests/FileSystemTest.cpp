@@ -0,0 +1,323 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: FileSystemTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "FileSystemTest.h"
+
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/Debug/Logger.h>
+#include <Skyborn/Util/AsyncIO.h>
+#include <Skyborn/Util/FileSystem.h>
+#include <Skyborn/Util/VirtualFS.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace sky;
+
+namespace
+{
+std::string temp_path(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+bool write_file(const std::string& path, const void* data, u64 size)
+{
+    utl::fs::file_handle file{};
+    if (!utl::fs::open(path.c_str(), utl::fs::file_modes::write, true, file))
+        return false;
+
+    u64        written{};
+    const bool ok{ utl::fs::write(file, size, data, written) };
+    utl::fs::close(file);
+    return ok;
+}
+} // anonymous namespace
+
+u8 mapped_files_match_their_contents()
+{
+    const std::string path{ temp_path("skyborn_mapped_file_test.bin") };
+    u8                data[100'000];
+    for (u32 i = 0; i < sizeof(data); ++i)
+        data[i] = (u8) (i * 31 + 7);
+    expects_to_be_true(write_file(path, data, sizeof(data)));
+
+    utl::fs::mapped_file file{};
+    expects_to_be_true(utl::fs::map(path.c_str(), file, utl::fs::map_hints::sequential));
+    expect_should_be(sizeof(data), file.bytes().size());
+    expects_to_be_true(memcmp(file.data, data, sizeof(data)) == 0);
+
+    // Hints are only hints, but they must accept unaligned ranges
+    utl::fs::prefetch(file, 5'000, 10'000);
+    utl::fs::advise(file, utl::fs::map_hints::random, 12'345);
+    expects_to_be_false(utl::fs::advise(file, utl::fs::map_hints::normal, sizeof(data)));
+    expect_should_be(data[99'999], file.bytes()[99'999]);
+
+    utl::fs::unmap(file);
+    expects_to_be_true(file.data == nullptr);
+    std::filesystem::remove(path);
+    return pass;
+}
+
+u8 mapping_empty_or_missing_files()
+{
+    const std::string path{ temp_path("skyborn_mapped_empty_test.bin") };
+    expects_to_be_true(write_file(path, nullptr, 0));
+
+    utl::fs::mapped_file file{};
+    expects_to_be_true(utl::fs::map(path.c_str(), file));
+    expects_to_be_true(file.bytes().empty());
+    utl::fs::unmap(file);
+    std::filesystem::remove(path);
+
+    expects_to_be_false(utl::fs::map(temp_path("skyborn_missing_file.bin").c_str(), file));
+    return pass;
+}
+
+u8 line_reader_handles_crlf_and_long_lines()
+{
+    const std::string path{ temp_path("skyborn_line_reader_test.txt") };
+    const std::string long_line(100, 'x');
+    const std::string text{ "first\r\nsecond\n\n" + long_line + "\r\nv 1.0 2.0 3.0\nno newline at the end" };
+    expects_to_be_true(write_file(path, text.data(), text.size()));
+
+    // A buffer smaller than the long line, so it has to grow, and small enough that lines straddle refills
+    utl::fs::line_reader reader{};
+    expects_to_be_true(utl::fs::open(path.c_str(), reader, 16));
+
+    const std::string_view expected[]{ "first", "second", "", long_line, "v 1.0 2.0 3.0", "no newline at the end" };
+    std::string_view       line;
+    for (const std::string_view& want : expected)
+    {
+        expects_to_be_true(utl::fs::read_line(reader, line));
+        expects_to_be_true(line == want);
+    }
+    expects_to_be_false(utl::fs::read_line(reader, line));
+    expects_to_be_false(utl::fs::read_line(reader, line));
+
+    utl::fs::close(reader);
+    std::filesystem::remove(path);
+    return pass;
+}
+
+namespace
+{
+struct transfer_totals
+{
+    u64 bytes{};
+    u32 completions{};
+    u32 errors{};
+};
+
+void count_transfer(const utl::aio::io_request& request, i64 result)
+{
+    auto& totals{ *(transfer_totals*) request.user_data };
+    ++totals.completions;
+    if (result < 0)
+        ++totals.errors;
+    else
+        totals.bytes += (u64) result;
+}
+
+bool round_trip(bool use_io_uring, bool& used_io_uring)
+{
+    if (!utl::aio::initialize({ 8, 2, use_io_uring }))
+        return false;
+    used_io_uring = utl::aio::using_io_uring();
+
+    constexpr u32 chunk  = 64 * 1024;
+    constexpr u32 chunks = 16;
+    const auto    source{ new u8[chunk * chunks] };
+    const auto    copy{ new u8[chunk * chunks + 100]{} }; // Room for the read past the end
+    for (u32 i = 0; i < chunk * chunks; ++i)
+        source[i] = (u8) (i * 13 + i / 4096);
+
+    const std::string path{ temp_path("skyborn_async_io_test.bin") };
+    utl::aio::io_file file{};
+    bool              ok{ utl::aio::open(path.c_str(), utl::fs::file_modes::read | utl::fs::file_modes::write, file) };
+
+    // Twice the queue depth, so the second half only goes in as the first completes
+    transfer_totals      written{};
+    utl::aio::io_request requests[chunks]{};
+    for (u32 i = 0; i < chunks; ++i)
+        requests[i] = { file, (u64) i * chunk, source + i * chunk, chunk, true, count_transfer, &written };
+
+    u32 submitted{ utl::aio::submit(requests, chunks) };
+    ok &= submitted == 8;
+    while (submitted < chunks)
+    {
+        utl::aio::poll();
+        submitted += utl::aio::submit(requests + submitted, chunks - submitted);
+    }
+    utl::aio::wait_all();
+    ok &= written.bytes == (u64) chunk * chunks && written.errors == 0 && utl::aio::file_size(file) == written.bytes;
+
+    // Read it back in reverse, with the last request running past the end of the file
+    transfer_totals read{};
+    for (u32 i = 0; i < chunks / 2; ++i)
+    {
+        const u32 c{ chunks - 1 - i };
+        const u32 size{ i == 0 ? chunk + 100 : chunk };
+        requests[i] = { file, (u64) c * chunk, copy + c * chunk, size, false, count_transfer, &read };
+    }
+    utl::aio::io_ticket tickets[chunks / 2];
+    ok &= utl::aio::submit(requests, chunks / 2, tickets) == chunks / 2;
+    utl::aio::wait(tickets[0]);
+    ok &= utl::aio::is_done(tickets[0]);
+    utl::aio::wait_all();
+
+    for (u32 i = 0; i < chunks / 2; ++i)
+        requests[i] = { file, (u64) i * chunk, copy + i * chunk, chunk, false, count_transfer, &read };
+    utl::aio::submit(requests, chunks / 2);
+    utl::aio::wait_all();
+    ok &= read.completions == chunks && read.errors == 0 && read.bytes == (u64) chunk * chunks;
+    ok &= memcmp(source, copy, chunk * chunks) == 0;
+
+    utl::aio::close(file);
+    utl::aio::shutdown();
+    std::filesystem::remove(path);
+    delete[] source;
+    delete[] copy;
+    return ok;
+}
+} // anonymous namespace
+
+u8 async_io_round_trips_through_io_uring()
+{
+    bool used_io_uring{};
+    expects_to_be_true(round_trip(true, used_io_uring));
+    if (!used_io_uring)
+        LOG_WARN("io_uring is unavailable here, so the thread pool was tested instead");
+    return pass;
+}
+
+u8 async_io_round_trips_through_the_thread_pool()
+{
+    bool used_io_uring{ true };
+    expects_to_be_true(round_trip(false, used_io_uring));
+    expects_to_be_false(used_io_uring);
+    return pass;
+}
+
+bool vfs_asset_is(const char* path, std::string_view contents)
+{
+    utl::vfs::asset file{};
+    if (!utl::vfs::open(path, file))
+        return false;
+
+    const bool same{ std::string_view{ (const char*) file.data, file.size } == contents };
+    utl::vfs::close(file);
+    return same;
+}
+
+u8 vfs_reads_packs_and_prefers_newer_mounts()
+{
+    namespace stdfs = std::filesystem;
+    const stdfs::path root{ temp_path("skyborn_vfs_test") };
+    stdfs::remove_all(root);
+    stdfs::create_directories(root / "assets" / "textures" / "ui");
+    stdfs::create_directories(root / "loose" / "textures");
+
+    const std::string big(10'000, 'b');
+    expects_to_be_true(write_file((root / "assets" / "readme.txt").string(), "hello", 5));
+    expects_to_be_true(
+        write_file((root / "assets" / "textures" / "ui" / "button.png").string(), big.data(), big.size()));
+    expects_to_be_true(write_file((root / "assets" / "textures" / "empty.bin").string(), nullptr, 0));
+    expects_to_be_true(write_file((root / "loose" / "textures" / "empty.bin").string(), "patched", 7));
+
+    const std::string pack{ (root / "assets.pak").string() };
+    expects_to_be_true(utl::vfs::build_pack((root / "assets").string().c_str(), pack.c_str()));
+    expects_to_be_true(utl::vfs::mount_pack(pack.c_str(), "", true));
+
+    expects_to_be_true(vfs_asset_is("readme.txt", "hello"));
+    expects_to_be_true(vfs_asset_is("textures/ui/button.png", big));
+    expects_to_be_true(vfs_asset_is("textures/empty.bin", ""));
+    expects_to_be_false(utl::vfs::exists("textures/missing.png"));
+    expects_to_be_false(vfs_asset_is("textures/missing.png", ""));
+
+    // Entries are aligned within the pack
+    utl::fs::mapped_file mapped{};
+    utl::vfs::asset      file{};
+    expects_to_be_true(utl::fs::map(pack.c_str(), mapped));
+    expects_to_be_true(utl::vfs::open("textures/ui/button.png", file));
+    expect_should_be(0, (u64) (file.data - mapped.data) % 64);
+    utl::vfs::close(file);
+    utl::fs::unmap(mapped);
+
+    // A newer loose mount overrides the pack for the paths under it
+    expects_to_be_true(utl::vfs::mount_directory((root / "loose" / "textures").string().c_str(), "textures"));
+    expects_to_be_true(vfs_asset_is("textures/empty.bin", "patched"));
+    expects_to_be_true(vfs_asset_is("textures/ui/button.png", big));
+    expects_to_be_true(utl::vfs::unmount("textures/"));
+    expects_to_be_true(vfs_asset_is("textures/empty.bin", ""));
+
+    utl::vfs::unmount_all();
+    expects_to_be_false(utl::vfs::exists("readme.txt"));
+    stdfs::remove_all(root);
+    return pass;
+}
+
+u8 vfs_rejects_corrupt_packs()
+{
+    namespace stdfs = std::filesystem;
+    const stdfs::path root{ temp_path("skyborn_vfs_corrupt_test") };
+    stdfs::remove_all(root);
+    stdfs::create_directories(root / "assets");
+    expects_to_be_true(write_file((root / "assets" / "data.bin").string(), "0123456789", 10));
+
+    const std::string pack{ (root / "assets.pak").string() };
+    expects_to_be_true(utl::vfs::build_pack((root / "assets").string().c_str(), pack.c_str()));
+
+    // Flip a byte of the entry, which starts at the first aligned offset after the header
+    {
+        std::fstream stream{ pack, std::ios::in | std::ios::out | std::ios::binary };
+        stream.seekp(64);
+        stream.put('X');
+    }
+    expects_to_be_true(utl::vfs::mount_pack(pack.c_str(), "unchecked"));
+    expects_to_be_true(utl::vfs::mount_pack(pack.c_str(), "checked", true));
+    expects_to_be_true(vfs_asset_is("unchecked/data.bin", "X123456789"));
+    expects_to_be_false(vfs_asset_is("checked/data.bin", "X123456789"));
+    utl::vfs::unmount_all();
+
+    expects_to_be_true(write_file(pack, "not a pack", 10));
+    expects_to_be_false(utl::vfs::mount_pack(pack.c_str()));
+    stdfs::remove_all(root);
+    return pass;
+}
+
+void register_filesystem_tests()
+{
+    tests::register_test(mapped_files_match_their_contents, "Mapped files should match their contents");
+    tests::register_test(async_io_round_trips_through_io_uring, "Async IO should round trip through io_uring");
+    tests::register_test(async_io_round_trips_through_the_thread_pool,
+                         "Async IO should round trip through the thread pool");
+    tests::register_test(line_reader_handles_crlf_and_long_lines, "Line reader should handle CRLF and long lines");
+    tests::register_test(mapping_empty_or_missing_files, "Mapping empty files should succeed, missing ones fail");
+    tests::register_test(vfs_reads_packs_and_prefers_newer_mounts, "VFS should read packs and prefer newer mounts");
+    tests::register_test(vfs_rejects_corrupt_packs, "VFS should reject corrupt packs and entries");
+}
\ No newline at end of file
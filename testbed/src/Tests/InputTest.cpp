@@ -0,0 +1,211 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: InputTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "InputTest.h"
+
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/Core/Actions.h>
+#include <Skyborn/Core/Event.h>
+#include <Skyborn/Core/Platform.h>
+
+using namespace sky;
+
+namespace
+{
+// Mirrors the edges input::latch reports when each key changes at most once per frame
+void next_frame(input::input_state& s)
+{
+    for (u32 i = 0; i < 4; ++i)
+    {
+        const u64 changed{ s.keys.words[i] ^ s.previous_keys.words[i] };
+        s.pressed_keys.words[i]  = changed & s.keys.words[i];
+        s.released_keys.words[i] = changed & s.previous_keys.words[i];
+    }
+    const u32 changed{ s.buttons ^ s.previous_buttons };
+    s.pressed_buttons  = changed & s.buttons;
+    s.released_buttons = changed & s.previous_buttons;
+}
+
+void end_frame(input::input_state& s)
+{
+    s.previous_keys    = s.keys;
+    s.previous_buttons = s.buttons;
+}
+} // anonymous namespace
+
+u8 key_bits_cover_every_key()
+{
+    input::key_bits bits{};
+    for (u16 k : { 0, 63, 64, 130, 255 })
+    {
+        bits.set(k, true);
+        expects_to_be_true(bits.test(k));
+    }
+    expects_to_be_false(bits.test(1));
+    expects_to_be_false(bits.test(65));
+
+    bits.set(130, false);
+    expects_to_be_false(bits.test(130));
+    expects_to_be_true(bits.test(255));
+
+    input::key_bits other{};
+    other.set(130, true);
+    expects_to_be_false(bits.intersects(other));
+    other.set(64, true);
+    expects_to_be_true(bits.intersects(other));
+    return pass;
+}
+
+u8 actions_follow_any_of_their_bindings()
+{
+    input::action_map actions{};
+    const input::action_id jump{ actions.add("jump") };
+    const input::action_id fire{ actions.add("fire") };
+    expect_should_be(jump, actions.add("jump"));
+    expect_should_be(fire, actions.find("fire"));
+    expect_should_be(u32_invalid, actions.find("crouch"));
+
+    actions.bind(jump, input::key::space);
+    actions.bind(jump, input::key::w);
+    actions.bind(fire, input::button::left);
+
+    input::input_state s{};
+    s.keys.set(input::key::space, true);
+    next_frame(s);
+    actions.update(s);
+    expects_to_be_true(s.key_pressed(input::key::space));
+    expects_to_be_true(actions.down(jump));
+    expects_to_be_true(actions.pressed(jump));
+    expects_to_be_false(actions.down(fire));
+    end_frame(s);
+
+    // A second binding going down while the first is held isn't another press
+    s.keys.set(input::key::w, true);
+    s.buttons |= 1u << input::button::left;
+    next_frame(s);
+    actions.update(s);
+    expects_to_be_false(s.key_pressed(input::key::space));
+    expects_to_be_true(s.key_pressed(input::key::w));
+    expects_to_be_true(actions.down(jump));
+    expects_to_be_false(actions.pressed(jump));
+    expects_to_be_true(actions.pressed(fire));
+    end_frame(s);
+
+    s.keys.set(input::key::space, false);
+    s.keys.set(input::key::w, false);
+    next_frame(s);
+    actions.update(s);
+    expects_to_be_true(s.key_released(input::key::w));
+    expects_to_be_false(actions.down(jump));
+    expects_to_be_true(actions.released(jump));
+    expects_to_be_true(actions.down(fire));
+    expects_to_be_false(actions.pressed(fire));
+    return pass;
+}
+
+u8 actions_see_taps_within_a_frame()
+{
+    input::action_map actions{};
+    const input::action_id jump{ actions.add("jump") };
+    const input::action_id fire{ actions.add("fire") };
+    actions.bind(jump, input::key::space);
+    actions.bind(fire, input::button::left);
+
+    // Both went down and back up between two latches, so they're not down but were pressed and released
+    input::input_state s{};
+    s.pressed_keys.set(input::key::space, true);
+    s.released_keys.set(input::key::space, true);
+    s.pressed_buttons  = 1u << input::button::left;
+    s.released_buttons = 1u << input::button::left;
+    actions.update(s);
+    expects_to_be_false(actions.down(jump));
+    expects_to_be_true(actions.pressed(jump));
+    expects_to_be_true(actions.released(jump));
+    expects_to_be_true(actions.pressed(fire));
+    expects_to_be_true(actions.released(fire));
+
+    s = {};
+    actions.update(s);
+    expects_to_be_false(actions.pressed(jump));
+    expects_to_be_false(actions.released(jump));
+    return pass;
+}
+
+u8 samples_keep_sub_frame_input()
+{
+    events::initialize();
+    input::initialize();
+
+    const f64 before{ platform::get_time() };
+    input::process_key(input::key::a, true);
+    input::process_key(input::key::a, false);
+    input::process_mouse_move(10, 20);
+    input::latch();
+
+    // Tapped within a frame: not down, but both edges are seen
+    const input::input_state& s{ input::state() };
+    expects_to_be_false(s.key_down(input::key::a));
+    expects_to_be_true(s.key_pressed(input::key::a));
+    expects_to_be_true(s.key_released(input::key::a));
+
+    u32                        count{};
+    const input::input_sample* samples{ input::frame_samples(count) };
+    expect_should_be(3, count);
+    expect_should_be(input::input_sample::kind::key, samples[0].type);
+    expect_should_be(input::key::a, samples[0].code);
+    expect_should_be(1, samples[0].pressed);
+    expect_should_be(0, samples[1].pressed);
+    expect_should_be(input::input_sample::kind::mouse_move, samples[2].type);
+    expect_should_be(20, samples[2].y);
+    expects_to_be_true(samples[0].time >= before && samples[2].time >= samples[0].time);
+
+    input::presented(samples[0].time + 0.01);
+    const input::latency_stats latency{ input::get_latency_stats() };
+    expect_should_be(1, latency.frames);
+    expect_float_to_equal(0.01, latency.last);
+
+    // Nothing arrived for the next frame, so it adds no latency sample
+    input::latch();
+    input::frame_samples(count);
+    expect_should_be(0, count);
+    expects_to_be_false(input::state().key_pressed(input::key::a));
+    input::presented(platform::get_time());
+    expect_should_be(1, input::get_latency_stats().frames);
+
+    input::shutdown();
+    events::shutdown();
+    return pass;
+}
+
+void register_input_tests()
+{
+    tests::register_test(key_bits_cover_every_key, "Key bits should set, clear and intersect across all four words");
+    tests::register_test(actions_follow_any_of_their_bindings,
+                         "Actions should be down while any binding is, with one press and release per hold");
+    tests::register_test(actions_see_taps_within_a_frame,
+                         "Actions should be pressed and released by a binding tapped within one frame");
+    tests::register_test(samples_keep_sub_frame_input,
+                         "Input samples should keep every transition within a frame, timestamped");
+}
\ No newline at end of file
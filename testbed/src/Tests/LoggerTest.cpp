@@ -0,0 +1,422 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: LoggerTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "LoggerTest.h"
+
+#include "AllocCounter.h"
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/Debug/Logger.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace sky;
+
+u8 async_logging_blocks_instead_of_dropping()
+{
+    // All the messages come from one call site, which the rate limit would otherwise cut short
+    logger::set_rate_limit(0);
+    expects_to_be_true(logger::start_async({ 16, logger::overflow_policy::block }));
+    expects_to_be_false(logger::start_async());
+
+    const u64 dropped_before{ logger::dropped_count() };
+    const u64 suppressed_before{ logger::suppressed_count() };
+    std::thread threads[4];
+    for (u32 t = 0; t < 4; ++t)
+    {
+        threads[t] = std::thread{ [t] {
+            for (u32 i = 0; i < 50; ++i)
+                LOG_INFO("Async message {} from thread {}", i, t);
+        } };
+    }
+    for (auto& t : threads)
+        t.join();
+
+    logger::flush();
+    logger::stop_async();
+    logger::set_rate_limit(100);
+    expect_should_be(dropped_before, logger::dropped_count());
+    expect_should_be(suppressed_before, logger::suppressed_count());
+    return pass;
+}
+
+u8 async_logging_stops_while_threads_log()
+{
+    logger::set_rate_limit(0);
+    std::atomic<u32> finished{};
+    std::thread      threads[2];
+    for (u32 t = 0; t < 2; ++t)
+    {
+        threads[t] = std::thread{ [t, &finished] {
+            for (u32 i = 0; i < 100; ++i)
+                LOG_INFO("Message {} from thread {} while async mode comes and goes", i, t);
+            finished.fetch_add(1);
+        } };
+    }
+
+    // Stopping frees the buffer, which must wait for the messages being pushed into it
+    while (finished.load() < 2)
+    {
+        expects_to_be_true(logger::start_async({ 8, logger::overflow_policy::block }));
+        logger::stop_async();
+    }
+    for (auto& t : threads)
+        t.join();
+
+    logger::flush();
+    logger::set_rate_limit(100);
+    return pass;
+}
+
+u8 async_logging_drops_when_full()
+{
+    // Two slots can't keep up with a tight loop, so most of these get dropped rather than stalling the caller
+    expects_to_be_true(logger::start_async({ 2, logger::overflow_policy::count }));
+
+    const u64  dropped_before{ logger::dropped_count() };
+    const auto start{ std::chrono::steady_clock::now() };
+    for (u32 i = 0; i < 200; ++i)
+        LOG_INFO("Burst message {}", i);
+    const auto elapsed{ std::chrono::steady_clock::now() - start };
+
+    logger::stop_async();
+    expects_to_be_true(logger::dropped_count() > dropped_before);
+    LOG_INFO("200 async messages took {} ns on the calling thread",
+             std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    return pass;
+}
+
+u8 async_logging_keeps_long_messages_whole()
+{
+    const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "skyborn_long_async_test" };
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    expects_to_be_true(logger::start_file_sink({ (directory / "long.log").string().c_str(), 64_KB, 0, 1,
+                                                 logger::log_level::fatal }));
+    expects_to_be_true(logger::start_async({ 16, logger::overflow_policy::block }));
+
+    // Too long for a cell, so it has to skip the buffer without jumping ahead of what's already in it
+    const std::string long_text(3 * logger::max_async_message, 'x');
+    LOG_INFO("Before the long message");
+    LOG_INFO("Long message {}", long_text);
+    LOG_INFO("After the long message");
+
+    logger::stop_async();
+    logger::stop_file_sink();
+
+    std::ifstream stream{ directory / "long.0.log" };
+    std::string   lines[3];
+    for (auto& line : lines)
+        std::getline(stream, line);
+    expects_to_be_true(lines[0].ends_with("Before the long message"));
+    expects_to_be_true(lines[1].ends_with("Long message " + long_text));
+    expects_to_be_true(lines[2].ends_with("After the long message"));
+
+    std::filesystem::remove_all(directory);
+    return pass;
+}
+
+namespace
+{
+struct decoded_lines
+{
+    std::string lines[8];
+    u32         count{};
+};
+
+void collect_line(logger::log_level::level, const char* line, void* user_data)
+{
+    auto& d{ *(decoded_lines*) user_data };
+    if (d.count < 8)
+        d.lines[d.count] = line;
+    ++d.count;
+}
+
+bool ends_with(const std::string& str, const char* suffix)
+{
+    const std::string_view s{ suffix };
+    return str.size() >= s.size() && str.compare(str.size() - s.size(), s.size(), s) == 0;
+}
+} // anonymous namespace
+
+u8 binary_logs_decode_to_the_same_text()
+{
+    const std::string path{ (std::filesystem::temp_directory_path() / "skyborn_binary_log_test.bin").string() };
+    logger::async_desc desc{ 64, logger::overflow_policy::block, true, path.c_str() };
+    expects_to_be_true(logger::start_async(desc));
+
+    const std::string name{ "player" };
+    const u8          small{ 200 };
+    LOG_INFO("Ints {} {} {}, floats {:.2f} {}", 42, -7, small, 3.14159, 0.5f);
+    LOG_INFO("{} is {} and {}", name, "ready", true);
+    LOG_INFO("Braces {{}} and char {}", 'x');
+    LOG_INFO("Reordered {1} {0}", "second", "first");
+    LOG_INFO("No arguments");
+    logger::stop_async();
+
+    decoded_lines decoded{};
+    expects_to_be_true(logger::decode_binary_log(path.c_str(), collect_line, &decoded));
+    expect_should_be(5, decoded.count);
+    expects_to_be_true(ends_with(decoded.lines[0], "[ INFO ]: Ints 42 -7 200, floats 3.14 0.5\n"));
+    expects_to_be_true(ends_with(decoded.lines[1], "player is ready and true\n"));
+    expects_to_be_true(ends_with(decoded.lines[2], "Braces {} and char x\n"));
+    expects_to_be_true(ends_with(decoded.lines[3], "Reordered first second\n"));
+    expects_to_be_true(ends_with(decoded.lines[4], "No arguments\n"));
+
+    std::filesystem::remove(path);
+    return pass;
+}
+
+u8 file_sink_rotates_without_losing_lines()
+{
+    const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "skyborn_file_sink_test" };
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::string path{ (directory / "soak.log").string() };
+
+    constexpr u32 thread_count = 4;
+    constexpr u32 lines        = 250;
+    logger::set_rate_limit(0);
+    expects_to_be_true(logger::start_file_sink({ path.c_str(), 8_KB, 0, 64, logger::log_level::fatal }));
+
+    std::thread writers[thread_count];
+    for (u32 t = 0; t < thread_count; ++t)
+    {
+        writers[t] = std::thread{ [t] {
+            for (u32 i = 0; i < lines; ++i)
+                LOG_INFO("File sink thread {} line {}", t, i);
+        } };
+    }
+    for (auto& writer : writers)
+        writer.join();
+    logger::stop_file_sink();
+    logger::set_rate_limit(100);
+
+    // Every line lands once, in order per thread, and files are trimmed to what was written
+    u32 next[thread_count]{};
+    u32 files{};
+    for (; std::filesystem::exists(directory / ("soak." + std::to_string(files) + ".log")); ++files)
+    {
+        const std::filesystem::path file{ directory / ("soak." + std::to_string(files) + ".log") };
+        expects_to_be_true(std::filesystem::file_size(file) <= 8_KB);
+
+        std::ifstream stream{ file };
+        std::string   line;
+        while (std::getline(stream, line))
+        {
+            u32 t{}, i{};
+            expects_to_be_true(sscanf(line.c_str(), "[%*8c][ INFO ]: File sink thread %u line %u", &t, &i) == 2);
+            expects_to_be_true(t < thread_count);
+            expect_should_be(next[t], i);
+            ++next[t];
+        }
+    }
+    expects_to_be_true(files > 1);
+    for (const u32 count : next)
+        expect_should_be(lines, count);
+
+    // A new run carries on from the last file instead of overwriting it
+    expects_to_be_true(logger::start_file_sink({ path.c_str(), 8_KB, 0, 64, logger::log_level::fatal }));
+    LOG_INFO("Second run");
+    logger::stop_file_sink();
+    expects_to_be_true(std::filesystem::exists(directory / ("soak." + std::to_string(files) + ".log")));
+
+    std::filesystem::remove_all(directory);
+    return pass;
+}
+
+u8 log_storms_are_limited_and_deduplicated()
+{
+    const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "skyborn_log_storm_test" };
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    expects_to_be_true(logger::start_file_sink({ (directory / "storm.log").string().c_str(), 64_KB, 0, 1,
+                                                 logger::log_level::fatal }));
+
+    // Unless the second ticks over midway, only the first 10 get through
+    logger::set_rate_limit(10);
+    u64 before{ logger::suppressed_count() };
+    for (u32 i = 0; i < 100; ++i)
+        LOG_INFO("Storm line {}", i);
+    const u64 limited{ logger::suppressed_count() - before };
+    expects_to_be_true(limited >= 80 && limited <= 90);
+
+    logger::set_rate_limit(0);
+    before = logger::suppressed_count();
+    for (u32 i = 0; i < 50; ++i)
+        LOG_WARN("Inflight fence wait failed");
+    LOG_INFO("Storm over");
+    expect_should_be(49, logger::suppressed_count() - before);
+
+    logger::stop_file_sink();
+    logger::set_rate_limit(100);
+
+    std::ifstream stream{ directory / "storm.0.log" };
+    std::string   line;
+    u32           storm_lines{}, fence_lines{};
+    bool          summarized{};
+    while (std::getline(stream, line))
+    {
+        storm_lines += line.find("Storm line") != std::string::npos;
+        fence_lines += line.find("Inflight fence wait failed") != std::string::npos;
+        summarized |= line.find("[ WARNING ]: Previous message repeated 49 times") != std::string::npos;
+    }
+    expect_should_be(100 - limited, storm_lines);
+    expect_should_be(1, fence_lines);
+    expects_to_be_true(summarized);
+
+    std::filesystem::remove_all(directory);
+    return pass;
+}
+
+u8 log_storms_are_reported_when_they_end_a_thread()
+{
+    const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "skyborn_last_storm_test" };
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    expects_to_be_true(logger::start_file_sink({ (directory / "storm.log").string().c_str(), 64_KB, 0, 1,
+                                                 logger::log_level::fatal }));
+    logger::set_rate_limit(0);
+
+    // Nothing else is logged after either storm, so only the thread exiting and the flush can report them
+    std::thread worker{ [] {
+        for (u32 i = 0; i < 20; ++i)
+            LOG_WARN("Worker lost its device");
+    } };
+    worker.join();
+    for (u32 i = 0; i < 30; ++i)
+        LOG_WARN("Main thread lost its device");
+    logger::flush();
+
+    logger::stop_file_sink();
+    logger::set_rate_limit(100);
+
+    std::ifstream stream{ directory / "storm.0.log" };
+    std::string   line;
+    bool          worker_summarized{}, main_summarized{};
+    while (std::getline(stream, line))
+    {
+        worker_summarized |= line.find("Previous message repeated 19 times") != std::string::npos;
+        main_summarized |= line.find("Previous message repeated 29 times") != std::string::npos;
+    }
+    expects_to_be_true(worker_summarized);
+    expects_to_be_true(main_summarized);
+
+    std::filesystem::remove_all(directory);
+    return pass;
+}
+
+u8 logging_does_not_allocate()
+{
+    const std::string name{ "player" };
+    const auto        log_frame = [&](u32 i) {
+        LOG_INFO("Frame {} took {:.3f} ms for {} on {} ({})", i, 16.6, name, "main", i % 2 == 0);
+    };
+
+    // The first message sets up the thread's buffers
+    log_frame(0);
+    u64 before{ thread_allocations() };
+    for (u32 i = 1; i <= 10; ++i)
+        log_frame(i);
+    expect_should_be(0, thread_allocations() - before);
+
+    expects_to_be_true(logger::start_async({ 64, logger::overflow_policy::block }));
+    log_frame(0);
+    before = thread_allocations();
+    for (u32 i = 1; i <= 10; ++i)
+        log_frame(i);
+    const u64 async_allocations{ thread_allocations() - before };
+    logger::stop_async();
+    expect_should_be(0, async_allocations);
+
+    return pass;
+}
+
+u8 filtered_logs_skip_their_arguments()
+{
+    const logger::log_level::level saved{ logger::get_level(logger::log_category::general) };
+    u32                            evaluated{};
+    const auto                     evaluate = [&] { return ++evaluated; };
+
+    logger::set_level(logger::log_category::general, logger::log_level::error);
+    LOG_INFO("Filtered {}", evaluate());
+    LOG_WARN("Filtered {}", evaluate());
+    expect_should_be(0, evaluated);
+
+    LOG_ERROR("Expected error from the filtering test, call {}", evaluate());
+    expect_should_be(1, evaluated);
+
+    // Other categories keep their own level
+    LOG_CAT(renderer, info, "Expected message from the filtering test, call {}", evaluate());
+    expect_should_be(2, evaluated);
+
+    logger::set_level(logger::log_category::general, saved);
+    return pass;
+}
+
+u8 log_levels_are_configured_from_a_spec()
+{
+    const logger::log_level::level saved{ logger::get_level(logger::log_category::general) };
+    expects_to_be_true(logger::configure("warn,vulkan=trace,frame=error"));
+    expect_should_be(logger::log_level::warn, logger::get_level(logger::log_category::general));
+    expect_should_be(logger::log_level::warn, logger::get_level(logger::log_category::renderer));
+    expect_should_be(logger::log_level::trace, logger::get_level(logger::log_category::vulkan));
+    expect_should_be(logger::log_level::error, logger::get_level(logger::log_category::frame));
+    expects_to_be_false(logger::is_enabled(logger::log_category::frame, logger::log_level::warn));
+
+    // Assignments before the bad one still apply
+    expects_to_be_false(logger::configure("input=debug,physics=info"));
+    expect_should_be(logger::log_level::debug, logger::get_level(logger::log_category::input));
+    expects_to_be_false(logger::configure("vulkan=loud"));
+    expect_should_be(logger::log_level::trace, logger::get_level(logger::log_category::vulkan));
+
+    logger::set_all_levels(saved);
+    return pass;
+}
+
+void register_logger_tests()
+{
+    tests::register_test(async_logging_blocks_instead_of_dropping,
+                         "Async logging with the block policy should write every message from every thread");
+    tests::register_test(async_logging_stops_while_threads_log,
+                         "Async mode should stop safely while other threads are logging");
+    tests::register_test(async_logging_drops_when_full,
+                         "Async logging should drop and count messages rather than stall when the buffer is full");
+    tests::register_test(async_logging_keeps_long_messages_whole,
+                         "Async logging should write messages longer than a buffer cell in full and in order");
+    tests::register_test(filtered_logs_skip_their_arguments, "Filtered log calls should not evaluate their arguments");
+    tests::register_test(log_levels_are_configured_from_a_spec, "Log levels should be set per category from a spec");
+    tests::register_test(file_sink_rotates_without_losing_lines, "File sink should rotate without losing lines");
+    tests::register_test(log_storms_are_limited_and_deduplicated, "Repeated log messages should be limited and merged");
+    tests::register_test(log_storms_are_reported_when_they_end_a_thread,
+                         "Repeats that are the last thing a thread logs should still be reported");
+    tests::register_test(logging_does_not_allocate, "Logging should not allocate on the calling thread");
+    tests::register_test(binary_logs_decode_to_the_same_text,
+                         "Binary log records should decode to the text the caller would have formatted");
+}
\ No newline at end of file
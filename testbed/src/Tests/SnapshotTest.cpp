@@ -0,0 +1,151 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: SnapshotTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "SnapshotTest.h"
+
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/Core/Snapshot.h>
+#include <Skyborn/ECS/World.h>
+
+#include <cstring>
+
+using namespace sky;
+
+namespace
+{
+struct game_state
+{
+    u64 frame;
+    f32 score;
+};
+
+struct body
+{
+    f32 x, y, vx, vy;
+};
+} // anonymous namespace
+
+u8 restores_registered_state()
+{
+    expects_to_be_true(snapshot::initialize({ 4, 1_KB }));
+
+    game_state state{ 1, 10.f };
+    snapshot::register_state("state", &state, sizeof(state));
+
+    for (u64 frame = 1; frame <= 6; ++frame)
+    {
+        state.frame = frame;
+        state.score = (f32) frame * 10.f;
+        expects_to_be_true(snapshot::save(frame));
+    }
+
+    // Only the last four frames fit in the ring
+    expects_to_be_false(snapshot::has_frame(2));
+    expects_to_be_true(snapshot::has_frame(3));
+
+    expects_to_be_true(snapshot::restore(4));
+    expect_should_be(4, state.frame);
+    expect_float_to_equal(40.f, state.score);
+    expects_to_be_false(snapshot::restore(1));
+
+    snapshot::shutdown();
+    return pass;
+}
+
+u8 rolls_back_a_world()
+{
+    expects_to_be_true(snapshot::initialize({ 2, 1_MB }));
+
+    ecs::world w{};
+    utl::vector<ecs::entity> bodies{};
+    for (u32 i = 0; i < 10000; ++i)
+        bodies.push_back(w.create(body{ (f32) i, 0.f, 1.f, 1.f }));
+
+    snapshot::register_world("world", &w);
+    expects_to_be_true(snapshot::save(0));
+    LOG_INFO("Saved {} entities in {} bytes, {:.1f} us", w.entity_count(), snapshot::stats().size,
+             snapshot::stats().save_us);
+
+    // Change values, destroy and create entities, then move everything to a new archetype
+    w.each<body>([](body& b) { b.x += 100.f; });
+    for (u32 i = 0; i < 10000; i += 3)
+        w.destroy(bodies[i]);
+    const ecs::entity extra{ w.create(body{}) };
+    w.add<game_state>(bodies[1]);
+
+    expects_to_be_true(snapshot::restore(0));
+    LOG_INFO("Restored in {:.1f} us", snapshot::stats().restore_us);
+
+    expect_should_be(10000, w.entity_count());
+    expects_to_be_true(w.is_alive(bodies[0]));
+    expects_to_be_false(w.is_alive(extra));
+    expects_to_be_false(w.has<game_state>(bodies[1]));
+    expect_float_to_equal(9999.f, w.get<body>(bodies[9999])->x);
+
+    // The world keeps working after a restore
+    const ecs::entity after{ w.create(body{ 5.f, 0.f, 0.f, 0.f }) };
+    expect_float_to_equal(5.f, w.get<body>(after)->x);
+    expect_should_be(10001, w.query_of<body>().count());
+
+    snapshot::shutdown();
+    return pass;
+}
+
+u8 failed_world_loads_change_nothing()
+{
+    ecs::world w{};
+    utl::vector<ecs::entity> bodies{};
+    for (u32 i = 0; i < 1000; ++i)
+        bodies.push_back(w.create(body{ (f32) i, 0.f, 0.f, 0.f }));
+
+    utl::vector<u8> save(w.snapshot_size());
+    w.save(save.data());
+    expects_to_be_true(w.can_load(save.data(), save.size()));
+
+    w.each<body>([](body& b) { b.y = 1.f; });
+
+    // Missing the end of the last chunk
+    expects_to_be_false(w.load(save.data(), save.size() - 1));
+
+    // Claiming one more archetype than the save holds
+    u32 archetype_count{};
+    memcpy(&archetype_count, save.data() + 2 * sizeof(u32), sizeof(u32));
+    ++archetype_count;
+    memcpy(save.data() + 2 * sizeof(u32), &archetype_count, sizeof(u32));
+    expects_to_be_false(w.load(save.data(), save.size()));
+
+    expect_should_be(1000, w.entity_count());
+    expects_to_be_true(w.is_alive(bodies[999]));
+    expect_float_to_equal(999.f, w.get<body>(bodies[999])->x);
+    expect_float_to_equal(1.f, w.get<body>(bodies[999])->y);
+    return pass;
+}
+
+void register_snapshot_tests()
+{
+    tests::register_test(restores_registered_state, "Snapshots should restore registered state from the ring");
+    tests::register_test(rolls_back_a_world, "Snapshots should roll back entities and components of a world");
+    tests::register_test(failed_world_loads_change_nothing, "A world that fails to load should be left unchanged");
+}
\ No newline at end of file
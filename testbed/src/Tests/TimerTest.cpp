@@ -0,0 +1,235 @@
+// ------------------------------------------------------------------------------
+//
+// Skyborn
+//    Copyright 2023 Matthew Rogers
+//
+//    This library is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU Lesser General Public License as
+//    published by the Free Software Foundation; either version 3 of the
+//    License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public
+//    License along with this library; if not, see <http://www.gnu.org/licenses/>.
+//
+// File Name: TimerTest.cpp
+// Date File Created: 10/18/2026
+// Author: Matt
+//
+// ------------------------------------------------------------------------------
+#include "TimerTest.h"
+
+#include "TestManager.h"
+#include "Expect.h"
+
+#include <Skyborn/Core/Event.h>
+#include <Skyborn/Core/Recorder.h>
+#include <Skyborn/Core/Timer.h>
+
+#include <filesystem>
+#include <string>
+
+using namespace sky;
+
+namespace
+{
+constexpr u16 timer_code = 0x300;
+
+struct fired
+{
+    f64 at[8]{};
+    u32 order[8]{};
+    u32 count{};
+    f64 now{};
+};
+
+struct tagged
+{
+    fired* log;
+    u32    tag;
+};
+
+void on_fired(timers::timer_id, u32, void* user_data)
+{
+    auto& t{ *(tagged*) user_data };
+    t.log->at[t.log->count]    = t.log->now;
+    t.log->order[t.log->count] = t.tag;
+    ++t.log->count;
+}
+
+struct repeating
+{
+    u32  calls{};
+    u32  expirations{};
+    bool cancel_self{};
+};
+
+void on_repeat(timers::timer_id id, u32 expirations, void* user_data)
+{
+    auto& r{ *(repeating*) user_data };
+    ++r.calls;
+    r.expirations += expirations;
+    if (r.cancel_self)
+        timers::cancel(id);
+}
+
+bool on_timer_event(u16, void*, void* listener, void* data)
+{
+    *(timers::timer_event*) listener = *(timers::timer_event*) data;
+    return true;
+}
+
+bool count_event(u16, void*, void* listener, void*)
+{
+    ++*(u32*) listener;
+    return false;
+}
+
+// Runs five frames like app::run, returning how many times the timer's event was delivered
+u32 run_timer_frames(bool schedule)
+{
+    events::initialize();
+    timers::initialize();
+    u32 delivered{};
+    events::register_event(timer_code, &delivered, count_event);
+    if (schedule)
+        timers::schedule_event(0.15, timer_code, 0.15);
+    for (u32 frame = 0; frame < 5; ++frame)
+    {
+        events::dispatch_queued();
+        sky::recorder::begin_frame(frame);
+        timers::advance(0.1);
+    }
+    events::dispatch_queued();
+    timers::shutdown();
+    events::shutdown();
+    return delivered;
+}
+} // anonymous namespace
+
+u8 timers_fire_in_order_of_expiry()
+{
+    expects_to_be_true(timers::initialize());
+
+    fired  log{};
+    tagged far{ &log, 2 }, near{ &log, 0 }, middle{ &log, 1 }, cancelled{ &log, 3 };
+    // 70s at 1ms ticks sits two levels up the wheel, so it has to cascade down to fire
+    timers::schedule(70.0, on_fired, &far);
+    timers::schedule(0.5, on_fired, &near);
+    timers::schedule(2.0, on_fired, &middle);
+    const timers::timer_id id{ timers::schedule(1.0, on_fired, &cancelled) };
+    expect_should_be(4, timers::pending_count());
+
+    expects_to_be_true(timers::cancel(id));
+    expects_to_be_false(timers::cancel(id));
+    expects_to_be_false(timers::is_pending(id));
+
+    constexpr f64 frame = 0.016;
+    while (log.now < 71.0)
+    {
+        log.now += frame;
+        timers::advance(frame);
+    }
+
+    expect_should_be(3, log.count);
+    expect_should_be(0, timers::pending_count());
+    const f64 expected[3]{ 0.5, 2.0, 70.0 };
+    for (u32 i = 0; i < 3; ++i)
+    {
+        expect_should_be(i, log.order[i]);
+        expects_to_be_true(log.at[i] > expected[i] - 0.001 && log.at[i] < expected[i] + frame + 0.001);
+    }
+
+    timers::shutdown();
+    return pass;
+}
+
+u8 repeating_timers_coalesce_per_advance()
+{
+    expects_to_be_true(timers::initialize());
+
+    repeating r{};
+    const timers::timer_id id{ timers::schedule(0.01, on_repeat, &r, 0.01) };
+
+    // A hitch ten intervals long fires once, reporting every missed expiry
+    timers::advance(0.1);
+    expect_should_be(1, r.calls);
+    expect_should_be(10, r.expirations);
+    expects_to_be_true(timers::is_pending(id));
+
+    timers::advance(0.01);
+    expect_should_be(2, r.calls);
+    expect_should_be(11, r.expirations);
+
+    r.cancel_self = true;
+    timers::advance(0.01);
+    expect_should_be(3, r.calls);
+    expects_to_be_false(timers::is_pending(id));
+
+    timers::advance(1.0);
+    expect_should_be(3, r.calls);
+    expect_should_be(0, timers::pending_count());
+
+    timers::shutdown();
+    return pass;
+}
+
+u8 timer_events_are_posted()
+{
+    events::initialize();
+    expects_to_be_true(timers::initialize());
+
+    timers::timer_event received{};
+    events::register_event(timer_code, &received, on_timer_event);
+
+    const timers::timer_id id{ timers::schedule_event(0.25, timer_code) };
+    timers::advance(0.2);
+    events::dispatch_queued();
+    expects_to_be_false(received.id.is_valid());
+
+    timers::advance(0.1);
+    events::dispatch_queued();
+    expects_to_be_true(received.id == id);
+    expect_should_be(1, received.expirations);
+
+    timers::shutdown();
+    events::shutdown();
+    return pass;
+}
+
+u8 timer_events_replay_once()
+{
+    const std::string path{ (std::filesystem::temp_directory_path() / "skyborn_timer_recording_test.bin").string() };
+
+    expects_to_be_true(sky::recorder::start_recording(path.c_str()));
+    const u32 live{ run_timer_frames(true) };
+    expects_to_be_true(sky::recorder::stop_recording());
+
+    expect_should_be(3, live);
+
+    // The wheel posts its events again in a replay, so the recording shouldn't have them
+    expects_to_be_true(sky::recorder::start_replay(path.c_str(), 0.1f, false));
+    expect_should_be(0, run_timer_frames(false));
+    sky::recorder::stop_replay();
+
+    expects_to_be_true(sky::recorder::start_replay(path.c_str(), 0.1f, false));
+    expect_should_be(live, run_timer_frames(true));
+    sky::recorder::stop_replay();
+    std::filesystem::remove(path);
+    return pass;
+}
+
+void register_timer_tests()
+{
+    tests::register_test(timers_fire_in_order_of_expiry,
+                         "Timers should fire in order of expiry, including ones that cascade down the wheel");
+    tests::register_test(repeating_timers_coalesce_per_advance,
+                         "Repeating timers should fire once per advance and report the expirations they coalesced");
+    tests::register_test(timer_events_are_posted, "Event timers should post their code when they expire");
+    tests::register_test(timer_events_replay_once,
+                         "Event timers shouldn't be recorded, and should fire once per expiry in a replay");
+}
\ No newline at end of file